@@ -11,6 +11,10 @@
 
 #include "BME280/BME280.h"
 
+#if !BME280_ENABLE_FLOAT_API || !BME280_ENABLE_DIAGNOSTICS
+#error "The bring-up CLI needs the float API and diagnostics (build without BME280_MINIMAL)"
+#endif
+
 // ============================================================================
 // Globals
 // ============================================================================
@@ -36,6 +40,41 @@ struct StressStats {
   BME280::Status lastError = BME280::Status::Ok();
 };
 
+/// Latency histogram: LATENCY_BIN_US per bin, last bin open-ended
+static constexpr size_t LATENCY_BINS = 256;
+static constexpr uint32_t LATENCY_BIN_US = 4;
+
+struct LatencyStats {
+  uint32_t count = 0;
+  uint32_t minUs = 0;
+  uint32_t maxUs = 0;
+  uint64_t sumUs = 0;
+  uint32_t bins[LATENCY_BINS] = {};
+};
+
+enum class BenchPhase : uint8_t {
+  FORCED,      ///< requestMeasurement() + status poll per sample
+  NORMAL,      ///< Free-running, 0.5 ms standby
+  CONTINUOUS,  ///< FORCED with fused read and auto re-arm
+  DONE
+};
+
+struct BenchStats {
+  bool active = false;
+  BenchPhase phase = BenchPhase::DONE;
+  int target = 0;
+  int samples = 0;
+  uint32_t errors = 0;
+  uint32_t startUs = 0;
+  LatencyStats tick;
+  LatencyStats get;
+  uint32_t transactions = 0;
+  uint64_t busUs = 0;           // Inside the I2C callbacks
+  uint64_t driverUs = 0;        // tick() + requestMeasurement() + getMeasurement()
+  uint64_t compensationUs = 0;  // Re-timed comp::compensate() per sample
+  BME280::Status lastError = BME280::Status::Ok();
+};
+
 struct ChipSettings {
   uint8_t ctrlHum = 0;
   uint8_t ctrlMeas = 0;
@@ -64,6 +103,10 @@ bool pendingRead = false;
 uint32_t pendingStartMs = 0;
 int stressRemaining = 0;
 StressStats stressStats;
+BME280::Config deviceConfig;
+uint32_t i2cFreqHz = board::I2C_FREQ_HZ;
+BenchStats benchStats;
+BME280::Calibration benchCalib;
 
 // ============================================================================
 // Helper Functions
@@ -162,8 +205,8 @@ void printStatus(const BME280::Status& st) {
                 errToStr(st.code),
                 static_cast<unsigned>(st.code),
                 static_cast<long>(st.detail));
-  if (st.msg && st.msg[0]) {
-    Serial.printf("  Message: %s\n", st.msg);
+  if (st.message()[0]) {
+    Serial.printf("  Message: %s\n", st.message());
   }
 }
 
@@ -540,8 +583,241 @@ void finishStressStats() {
 
   if (!stressStats.lastError.ok()) {
     Serial.printf("  Last error: %s\n", errToStr(stressStats.lastError.code));
-    if (stressStats.lastError.msg && stressStats.lastError.msg[0]) {
-      Serial.printf("  Message: %s\n", stressStats.lastError.msg);
+    if (stressStats.lastError.message()[0]) {
+      Serial.printf("  Message: %s\n", stressStats.lastError.message());
+    }
+  }
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+void resetLatency(LatencyStats& stats) {
+  stats = LatencyStats();
+  stats.minUs = std::numeric_limits<uint32_t>::max();
+}
+
+void recordLatency(LatencyStats& stats, uint32_t us) {
+  stats.count++;
+  stats.sumUs += us;
+  if (us < stats.minUs) {
+    stats.minUs = us;
+  }
+  if (us > stats.maxUs) {
+    stats.maxUs = us;
+  }
+  const uint32_t bin = us / LATENCY_BIN_US;
+  stats.bins[(bin < LATENCY_BINS) ? bin : LATENCY_BINS - 1]++;
+}
+
+/// Upper bound of the bin holding the pct-th percentile (capped at the maximum)
+uint32_t latencyPercentile(const LatencyStats& stats, uint32_t pct) {
+  if (stats.count == 0) {
+    return 0;
+  }
+  const uint64_t rank = (static_cast<uint64_t>(stats.count) * pct + 99) / 100;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < LATENCY_BINS - 1; ++i) {
+    seen += stats.bins[i];
+    if (seen >= rank) {
+      const uint32_t upper = static_cast<uint32_t>((i + 1) * LATENCY_BIN_US - 1);
+      return (upper < stats.maxUs) ? upper : stats.maxUs;
+    }
+  }
+  return stats.maxUs;
+}
+
+void printLatency(const char* label, const LatencyStats& stats) {
+  if (stats.count == 0) {
+    Serial.printf("  %s us: no calls\n", label);
+    return;
+  }
+  Serial.printf("  %s us: min=%lu avg=%.1f p99=%lu max=%lu (n=%lu)\n", label,
+                static_cast<unsigned long>(stats.minUs),
+                static_cast<double>(stats.sumUs) / stats.count,
+                static_cast<unsigned long>(latencyPercentile(stats, 99)),
+                static_cast<unsigned long>(stats.maxUs),
+                static_cast<unsigned long>(stats.count));
+}
+
+const char* benchPhaseToStr(BenchPhase phase) {
+  switch (phase) {
+    case BenchPhase::FORCED:     return "FORCED";
+    case BenchPhase::NORMAL:     return "NORMAL";
+    case BenchPhase::CONTINUOUS: return "CONTINUOUS (fused + re-arm)";
+    default:                     return "DONE";
+  }
+}
+
+BME280::Status benchWrite(uint8_t addr, const uint8_t* data, size_t len,
+                          uint32_t timeoutMs, void* user) {
+  const uint32_t start = micros();
+  const BME280::Status st = transport::wireWrite(addr, data, len, timeoutMs, user);
+  benchStats.busUs += micros() - start;
+  benchStats.transactions++;
+  return st;
+}
+
+BME280::Status benchWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                              uint8_t* rxData, size_t rxLen,
+                              uint32_t timeoutMs, void* user) {
+  const uint32_t start = micros();
+  const BME280::Status st = transport::wireWriteRead(addr, txData, txLen, rxData, rxLen,
+                                                     timeoutMs, user);
+  benchStats.busUs += micros() - start;
+  benchStats.transactions++;
+  return st;
+}
+
+/// Compensation runs inside tick(); time the same call on the sample's raw values
+uint32_t timeCompensation(const BME280::RawSample& raw) {
+  BME280::CompensatedSample out;
+  int32_t tFine = 0;
+  const uint32_t start = micros();
+  BME280::comp::compensate(benchCalib, raw, out, tFine, device.channels());
+  return micros() - start;
+}
+
+void noteBenchError(const BME280::Status& st) {
+  benchStats.errors++;
+  benchStats.lastError = st;
+}
+
+/// Copy the current device settings so the bench phases use them and stopBench() restores them
+void captureDeviceSettings(BME280::Config& cfg) {
+  device.getMode(cfg.mode);
+  device.getOversamplingT(cfg.osrsT);
+  device.getOversamplingP(cfg.osrsP);
+  device.getOversamplingH(cfg.osrsH);
+  device.getFilter(cfg.filter);
+  device.getStandby(cfg.standby);
+}
+
+/// Restore the interactive configuration (Wire callbacks, user settings)
+void stopBench() {
+  benchStats.active = false;
+  benchStats.phase = BenchPhase::DONE;
+  const BME280::Status st = device.begin(deviceConfig);
+  if (!st.ok()) {
+    LOGE("Failed to restore configuration");
+    printStatus(st);
+  }
+}
+
+bool startBenchPhase(BenchPhase phase) {
+  BME280::Config cfg = deviceConfig;
+  cfg.i2cWrite = benchWrite;
+  cfg.i2cWriteRead = benchWriteRead;
+  cfg.standby = BME280::Standby::MS_0_5;
+  cfg.fusedRead = false;
+  cfg.forcedAutoRearm = false;
+  if (phase == BenchPhase::NORMAL) {
+    cfg.mode = BME280::Mode::NORMAL;
+  } else {
+    cfg.mode = BME280::Mode::FORCED;
+  }
+  if (phase == BenchPhase::CONTINUOUS) {
+    cfg.fusedRead = true;
+    cfg.forcedAutoRearm = true;
+  }
+
+  const BME280::Status st = device.begin(cfg);
+  if (!st.ok()) {
+    LOGE("Bench %s: begin failed", benchPhaseToStr(phase));
+    printStatus(st);
+    return false;
+  }
+  device.getCalibration(benchCalib);
+
+  benchStats.phase = phase;
+  benchStats.samples = 0;
+  benchStats.errors = 0;
+  resetLatency(benchStats.tick);
+  resetLatency(benchStats.get);
+  benchStats.transactions = 0;
+  benchStats.busUs = 0;
+  benchStats.driverUs = 0;
+  benchStats.compensationUs = 0;
+  benchStats.lastError = BME280::Status::Ok();
+  benchStats.startUs = micros();
+  return true;
+}
+
+void finishBenchPhase() {
+  const uint32_t wallUs = micros() - benchStats.startUs;
+  const int samples = benchStats.samples;
+  const double perSample = (samples > 0) ? 1.0 / samples : 0.0;
+
+  Serial.printf("=== Bench: %s @ %lu kHz ===\n", benchPhaseToStr(benchStats.phase),
+                static_cast<unsigned long>(i2cFreqHz / 1000));
+  Serial.printf("  Samples: %d (errors: %lu) in %lu ms\n", samples,
+                static_cast<unsigned long>(benchStats.errors),
+                static_cast<unsigned long>(wallUs / 1000));
+  if (wallUs > 0) {
+    Serial.printf("  Rate: %.2f samples/s\n", 1e6 * samples / static_cast<double>(wallUs));
+  }
+  printLatency("tick()", benchStats.tick);
+  printLatency("getMeasurement()", benchStats.get);
+  Serial.printf("  Bus transactions/sample: %.2f\n", benchStats.transactions * perSample);
+
+  const double busUs = static_cast<double>(benchStats.busUs) * perSample;
+  const double compUs = static_cast<double>(benchStats.compensationUs) * perSample;
+  const double driverUs = static_cast<double>(benchStats.driverUs) * perSample;
+  const double idleUs = static_cast<double>(wallUs) * perSample - driverUs;
+  Serial.printf("  Per sample us: bus=%.1f compensation=%.1f other=%.1f waiting=%.1f\n",
+                busUs, compUs, driverUs - busUs - compUs, idleUs);
+  if (!benchStats.lastError.ok()) {
+    Serial.printf("  Last error: %s\n", errToStr(benchStats.lastError.code));
+  }
+
+  const BenchPhase next = static_cast<BenchPhase>(static_cast<uint8_t>(benchStats.phase) + 1);
+  if (next == BenchPhase::DONE || !startBenchPhase(next)) {
+    stopBench();
+    LOGI("Bench complete");
+  }
+}
+
+void benchStep() {
+  uint32_t start = micros();
+  device.tick(millis());
+  uint32_t elapsed = micros() - start;
+  recordLatency(benchStats.tick, elapsed);
+  benchStats.driverUs += elapsed;
+
+  if (device.measurementReady()) {
+    BME280::RawSample raw;
+    device.getRawSample(raw);
+    BME280::Measurement m;
+    start = micros();
+    const BME280::Status st = device.getMeasurement(m);
+    elapsed = micros() - start;
+    recordLatency(benchStats.get, elapsed);
+    benchStats.driverUs += elapsed;
+    if (st.ok()) {
+      benchStats.samples++;
+      benchStats.compensationUs += timeCompensation(raw);
+    } else {
+      noteBenchError(st);
+    }
+  }
+
+  if (benchStats.samples >= benchStats.target) {
+    finishBenchPhase();
+    return;
+  }
+  if (benchStats.errors > static_cast<uint32_t>(benchStats.target)) {
+    LOGW("Bench %s: too many errors", benchPhaseToStr(benchStats.phase));
+    finishBenchPhase();
+    return;
+  }
+
+  if (!device.measurementPending() && !device.measurementReady()) {
+    start = micros();
+    const BME280::Status st = device.requestMeasurement();
+    benchStats.driverUs += micros() - start;
+    if (!st.ok() && st.code != BME280::Err::IN_PROGRESS && st.code != BME280::Err::BUSY) {
+      noteBenchError(st);
     }
   }
 }
@@ -550,6 +826,9 @@ void cancelPending() {
   pendingRead = false;
   stressRemaining = 0;
   stressStats.active = false;
+  if (benchStats.active) {
+    stopBench();
+  }
 }
 
 BME280::Status scheduleMeasurement() {
@@ -651,6 +930,8 @@ void printHelp() {
   Serial.println("  recover                 - Manual recovery attempt");
   Serial.println("  verbose [0|1]            - Enable/disable verbose output");
   Serial.println("  stress [N]              - Run N measurement cycles");
+  Serial.println("  bench [N]               - N samples each in FORCED, NORMAL, CONTINUOUS");
+  Serial.println("  clock [kHz]             - Set or show I2C clock (e.g. 100, 400, 1000)");
 }
 
 // ============================================================================
@@ -892,6 +1173,45 @@ void processCommand(const String& cmdLine) {
     return;
   }
 
+  if (cmd == "bench" || cmd.startsWith("bench ")) {
+    int count = 50;
+    if (cmd.length() > 5) {
+      count = cmd.substring(5).toInt();
+    }
+    if (count <= 0) {
+      LOGW("Invalid bench count");
+      return;
+    }
+
+    cancelPending();
+    captureDeviceSettings(deviceConfig);
+    benchStats.target = count;
+    if (startBenchPhase(BenchPhase::FORCED)) {
+      benchStats.active = true;
+      LOGI("Starting bench: %d samples per mode", count);
+    } else {
+      stopBench();
+    }
+    return;
+  }
+
+  if (cmd == "clock") {
+    Serial.printf("I2C clock: %lu kHz\n", static_cast<unsigned long>(i2cFreqHz / 1000));
+    return;
+  }
+
+  if (cmd.startsWith("clock ")) {
+    const long khz = cmd.substring(6).toInt();
+    if (khz < 10 || khz > 1000) {
+      LOGW("Invalid clock (10..1000 kHz)");
+      return;
+    }
+    i2cFreqHz = static_cast<uint32_t>(khz) * 1000U;
+    Wire.setClock(i2cFreqHz);
+    LOGI("I2C clock: %ld kHz", khz);
+    return;
+  }
+
   LOGW("Unknown command: %s", cmd.c_str());
 }
 
@@ -912,7 +1232,7 @@ void setup() {
 
   i2c::scan();
 
-  BME280::Config cfg;
+  BME280::Config& cfg = deviceConfig;
   cfg.i2cWrite = transport::wireWrite;
   cfg.i2cWriteRead = transport::wireWriteRead;
   cfg.i2cAddress = 0x76;
@@ -933,7 +1253,11 @@ void setup() {
 }
 
 void loop() {
-  device.tick(millis());
+  if (benchStats.active) {
+    benchStep();
+  } else {
+    device.tick(millis());
+  }
 
   if (stressStats.active && stressRemaining > 0 && !pendingRead) {
     const BME280::Status st = scheduleMeasurement();
@@ -0,0 +1,64 @@
+/// @file main.cpp
+/// @brief Minimal-footprint BME280 example (FORCED mode, fixed-point output)
+/// @note This is an EXAMPLE, not part of the library
+///
+/// Builds in every profile. The ex_minimal_* environments compile it with
+/// -DBME280_MINIMAL=1 (and ex_minimal_s3_full without) to track the savings.
+
+#include <Arduino.h>
+#include "common/Log.h"
+#include "common/BoardConfig.h"
+#include "common/I2cTransport.h"
+
+#include "BME280/BME280.h"
+
+static constexpr uint32_t SAMPLE_PERIOD_MS = 1000;
+
+BME280::BME280 device;
+uint32_t nextSampleMs = 0;
+
+void setup() {
+  log_begin(115200);
+
+  if (!board::initI2c()) {
+    LOGE("Failed to initialize I2C");
+    return;
+  }
+
+  BME280::Config cfg;
+  cfg.i2cWrite = transport::wireWrite;
+  cfg.i2cWriteRead = transport::wireWriteRead;
+  cfg.i2cAddress = 0x76;
+  cfg.i2cTimeoutMs = board::I2C_TIMEOUT_MS;
+
+  const BME280::Status st = device.begin(cfg);
+  if (!st.ok()) {
+    // Compact Status: code and detail only
+    LOGE("begin() failed: code=%u detail=%ld", static_cast<unsigned>(st.code),
+         static_cast<long>(st.detail));
+    return;
+  }
+  LOGI("BME280 ready");
+}
+
+void loop() {
+  const uint32_t nowMs = millis();
+  device.tick(nowMs);
+
+  if (static_cast<int32_t>(nowMs - nextSampleMs) >= 0) {
+    nextSampleMs = nowMs + SAMPLE_PERIOD_MS;
+    device.requestMeasurement();
+  }
+
+  BME280::CompensatedSample s;
+  if (device.getMeasurement(s).ok()) {
+    // Integer formatting keeps printf float support out of the image
+    const int32_t t = s.tempC_x100;
+    const uint32_t rh = (s.humidityPct_x1024 * 100U + 512U) / 1024U;  // %RH * 100
+    Serial.printf("T=%s%ld.%02ld C  P=%lu Pa  RH=%lu.%02lu %%\n", (t < 0) ? "-" : "",
+                  static_cast<long>((t < 0 ? -t : t) / 100),
+                  static_cast<long>((t < 0 ? -t : t) % 100),
+                  static_cast<unsigned long>(s.pressurePa),
+                  static_cast<unsigned long>(rh / 100), static_cast<unsigned long>(rh % 100));
+  }
+}
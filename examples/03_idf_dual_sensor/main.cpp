@@ -0,0 +1,69 @@
+/// @file main.cpp
+/// @brief Two BME280s (0x76 and 0x77) on one ESP-IDF i2c_master bus
+/// @note This is an EXAMPLE, not part of the library
+///
+/// Both drivers share one transport::IdfI2c context, which keeps a device handle
+/// per address, and a Group interleaves their FORCED conversions. Needs
+/// Arduino-ESP32 3.x (ESP-IDF 5.2+); built as ex_idf_dual_s3.
+
+#include <Arduino.h>
+#include "common/Log.h"
+#include "common/BoardConfig.h"
+#include "common/I2cTransportIdf.h"
+
+#include "BME280/BME280.h"
+#include "BME280/Group.h"
+
+#if !__has_include("driver/i2c_master.h")
+#error "03_idf_dual_sensor needs ESP-IDF 5.2+ (Arduino-ESP32 3.x)"
+#endif
+
+static constexpr int I2C_PORT = 0;
+static constexpr uint8_t ADDRESSES[2] = {0x76, 0x77};
+
+transport::IdfI2c i2c;
+BME280::Group<2> group;
+
+static void onSample(size_t index, const BME280::CompensatedSample& s, uint32_t nowMs,
+                     void* user) {
+  (void)user;
+  Serial.printf("[%lu] 0x%02X T=%ld (0.01 C) P=%lu Pa RH=%lu (1/1024 %%)\n",
+                static_cast<unsigned long>(nowMs), ADDRESSES[index],
+                static_cast<long>(s.tempC_x100), static_cast<unsigned long>(s.pressurePa),
+                static_cast<unsigned long>(s.humidityPct_x1024));
+}
+
+void setup() {
+  log_begin(115200);
+
+  if (!transport::initIdf(i2c, I2C_PORT, board::I2C_SDA, board::I2C_SCL,
+                          board::I2C_FREQ_HZ)) {
+    LOGE("Failed to create the i2c_master bus");
+    return;
+  }
+
+  for (size_t i = 0; i < group.size(); ++i) {
+    BME280::Config cfg;
+    cfg.i2cWrite = transport::idfWrite;
+    cfg.i2cWriteRead = transport::idfWriteRead;
+    cfg.i2cUser = &i2c;
+    cfg.i2cAddress = ADDRESSES[i];
+    cfg.i2cTimeoutMs = board::I2C_TIMEOUT_MS;
+
+    const BME280::Status st = group.device(i).begin(cfg);
+    if (!st.ok()) {
+      LOGE("begin(0x%02X) failed: %s", ADDRESSES[i], st.message());
+    }
+  }
+
+  group.setCallback(onSample, nullptr);
+  if (!group.start(millis()).ok()) {
+    LOGE("No sensor found");
+    return;
+  }
+  LOGI("Sampling %u sensors", static_cast<unsigned>(group.size()));
+}
+
+void loop() {
+  group.tick(millis());
+}
@@ -85,9 +85,7 @@ inline Status wireWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
     return Status::Error(Err::I2C_ERROR, "I2C read incomplete", static_cast<int32_t>(received));
   }
   
-  for (size_t i = 0; i < rxLen; i++) {
-    rxData[i] = Wire.read();
-  }
+  Wire.readBytes(rxData, rxLen);
   
   return Status::Ok();
 }
@@ -0,0 +1,153 @@
+/// @file I2cTransportIdf.h
+/// @brief ESP-IDF i2c_master transport adapter for examples
+/// @note NOT part of the library - examples only
+/// @note Requires ESP-IDF 5.2+ (Arduino-ESP32 3.x). Do not use Wire on the same port.
+#pragma once
+
+#if __has_include("driver/i2c_master.h")
+
+#include <cstddef>
+#include <driver/i2c_master.h>
+#include "BME280/Status.h"
+
+namespace transport {
+
+using BME280::Status;
+using BME280::Err;
+
+/// Device handles cached per bus (e.g. 0x76 and 0x77 plus spares)
+static constexpr size_t IDF_MAX_DEVICES = 4;
+
+/// i2c_master bus with one cached handle per device address; pass as Config::i2cUser
+/// Drivers for different addresses can share one context: each address is added to
+/// the bus on first use and keeps its handle until deinitIdf().
+struct IdfI2c {
+  i2c_master_bus_handle_t bus = nullptr;
+  i2c_master_dev_handle_t dev[IDF_MAX_DEVICES] = {};
+  uint8_t devAddr[IDF_MAX_DEVICES] = {};
+  size_t devCount = 0;
+  uint32_t freqHz = 400000;
+};
+
+/// Create the i2c_master bus
+/// @param ctx Transport context to initialize
+/// @param port I2C port number
+/// @param sda SDA pin
+/// @param scl SCL pin
+/// @param freqHz I2C clock frequency
+/// @return true if initialized
+inline bool initIdf(IdfI2c& ctx, int port, int sda, int scl, uint32_t freqHz) {
+  i2c_master_bus_config_t busCfg = {};
+  busCfg.i2c_port = static_cast<i2c_port_num_t>(port);
+  busCfg.sda_io_num = static_cast<gpio_num_t>(sda);
+  busCfg.scl_io_num = static_cast<gpio_num_t>(scl);
+  busCfg.clk_source = I2C_CLK_SRC_DEFAULT;
+  busCfg.glitch_ignore_cnt = 7;
+  busCfg.flags.enable_internal_pullup = true;
+
+  ctx.devCount = 0;
+  ctx.freqHz = freqHz;
+  return i2c_new_master_bus(&busCfg, &ctx.bus) == ESP_OK;
+}
+
+/// Release the device handles and the bus
+inline void deinitIdf(IdfI2c& ctx) {
+  for (size_t i = 0; i < ctx.devCount; ++i) {
+    i2c_master_bus_rm_device(ctx.dev[i]);
+    ctx.dev[i] = nullptr;
+  }
+  ctx.devCount = 0;
+  if (ctx.bus != nullptr) {
+    i2c_del_master_bus(ctx.bus);
+    ctx.bus = nullptr;
+  }
+}
+
+/// Get the device handle for addr, adding it to the bus on first use
+/// @return nullptr if the bus is not initialized, the table is full or the add fails
+inline i2c_master_dev_handle_t idfDevice(IdfI2c& ctx, uint8_t addr) {
+  for (size_t i = 0; i < ctx.devCount; ++i) {
+    if (ctx.devAddr[i] == addr) {
+      return ctx.dev[i];
+    }
+  }
+  if (ctx.bus == nullptr || ctx.devCount >= IDF_MAX_DEVICES) {
+    return nullptr;
+  }
+
+  i2c_device_config_t devCfg = {};
+  devCfg.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+  devCfg.device_address = addr;
+  devCfg.scl_speed_hz = ctx.freqHz;
+  i2c_master_dev_handle_t dev = nullptr;
+  if (i2c_master_bus_add_device(ctx.bus, &devCfg, &dev) != ESP_OK) {
+    return nullptr;
+  }
+  ctx.dev[ctx.devCount] = dev;
+  ctx.devAddr[ctx.devCount] = addr;
+  ctx.devCount++;
+  return dev;
+}
+
+/// Map esp_err_t to Status
+inline Status idfStatus(esp_err_t err, const char* msg) {
+  if (err == ESP_OK) {
+    return Status::Ok();
+  }
+  if (err == ESP_ERR_TIMEOUT) {
+    return Status::Error(Err::TIMEOUT, "I2C timeout", static_cast<int32_t>(err));
+  }
+  return Status::Error(Err::I2C_ERROR, msg, static_cast<int32_t>(err));
+}
+
+/// I2C write callback using i2c_master
+/// @param addr I2C device address (7-bit)
+/// @param data Data buffer to write
+/// @param len Number of bytes to write
+/// @param timeoutMs Per-transaction timeout
+/// @param user IdfI2c context
+/// @return Status indicating success or failure
+inline Status idfWrite(uint8_t addr, const uint8_t* data, size_t len,
+                       uint32_t timeoutMs, void* user) {
+  IdfI2c* ctx = static_cast<IdfI2c*>(user);
+  if (ctx == nullptr) {
+    return Status::Error(Err::INVALID_CONFIG, "I2C context not set");
+  }
+  i2c_master_dev_handle_t dev = idfDevice(*ctx, addr);
+  if (dev == nullptr) {
+    return Status::Error(Err::I2C_ERROR, "I2C device add failed");
+  }
+
+  const esp_err_t err = i2c_master_transmit(dev, data, len, static_cast<int>(timeoutMs));
+  return idfStatus(err, "I2C write failed");
+}
+
+/// I2C write-then-read callback using i2c_master (repeated start, direct read)
+/// @param addr I2C device address (7-bit)
+/// @param txData Data buffer to write
+/// @param txLen Number of bytes to write
+/// @param rxData Buffer for read data
+/// @param rxLen Number of bytes to read
+/// @param timeoutMs Per-transaction timeout
+/// @param user IdfI2c context
+/// @return Status indicating success or failure
+inline Status idfWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                           uint8_t* rxData, size_t rxLen,
+                           uint32_t timeoutMs, void* user) {
+  IdfI2c* ctx = static_cast<IdfI2c*>(user);
+  if (ctx == nullptr) {
+    return Status::Error(Err::INVALID_CONFIG, "I2C context not set");
+  }
+  i2c_master_dev_handle_t dev = idfDevice(*ctx, addr);
+  if (dev == nullptr) {
+    return Status::Error(Err::I2C_ERROR, "I2C device add failed");
+  }
+
+  const esp_err_t err = i2c_master_transmit_receive(dev, txData, txLen, rxData, rxLen,
+                                                    static_cast<int>(timeoutMs));
+  return idfStatus(err, "I2C write-read failed");
+}
+
+} // namespace transport
+
+#endif // __has_include("driver/i2c_master.h")
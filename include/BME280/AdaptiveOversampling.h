@@ -0,0 +1,88 @@
+/// @file AdaptiveOversampling.h
+/// @brief Oversampling controller driven by the observed sample-to-sample noise
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/BME280.h"
+
+namespace BME280 {
+
+/// Noise target and oversampling bounds for one channel
+struct AdaptiveChannelConfig {
+  uint32_t targetNoise = 0;              ///< Target noise (std dev) in field units; 0 disables
+  Oversampling min = Oversampling::X1;   ///< Lowest setting the controller may select
+  Oversampling max = Oversampling::X16;  ///< Highest setting the controller may select
+};
+
+/// Settings for AdaptiveOversampling
+struct AdaptiveOversamplingConfig {
+  AdaptiveChannelConfig temperature;  ///< tempC_x100
+  AdaptiveChannelConfig pressure;     ///< pressurePa
+  AdaptiveChannelConfig humidity;     ///< humidityPct_x1024
+  uint16_t blockSamples = 32;         ///< Samples per noise estimate (at least 4)
+};
+
+/// Noise variance per channel from the last completed block, in field units^2
+struct NoiseEstimate {
+  uint64_t temperature = 0;
+  uint64_t pressure = 0;
+  uint64_t humidity = 0;
+};
+
+/// Steps osrsT/P/H to the lowest setting that meets a noise target
+///
+/// Noise is estimated per block as half the mean squared difference between
+/// consecutive samples, which cancels slow signal changes. At the end of a block,
+/// each controlled channel steps up one setting if the estimate is above the target,
+/// or down one if the estimate doubled (one setting lower) would still be at most
+/// 80 % of the target. All changes of a block are applied with one setConfigBatch()
+/// call (one bus transaction), and the next sample is discarded because its
+/// conversion may have started with the old settings.
+/// The first update() after construction or configure() only moves settings that
+/// lie outside [min, max] into the bounds; that sample is not part of a block.
+///
+/// Call update() from the task that calls tick(), not from Config::sampleCallback.
+/// Enable the software filter or hardware IIR only if their lag is acceptable: they
+/// lower the measured noise, so the controller selects less oversampling.
+class AdaptiveOversampling {
+public:
+  explicit AdaptiveOversampling(const AdaptiveOversamplingConfig& config =
+                                    AdaptiveOversamplingConfig());
+
+  /// Replace the settings and restart the current block
+  void configure(const AdaptiveOversamplingConfig& config);
+
+  /// Current settings
+  const AdaptiveOversamplingConfig& config() const { return _config; }
+
+  /// Discard the current block
+  void reset();
+
+  /// Feed one sample read from device
+  /// @return Ok, or the setConfigBatch() error (the change is retried after the next block)
+  Status update(BME280& device, const CompensatedSample& sample);
+
+  /// Estimates from the last completed block
+  const NoiseEstimate& lastEstimate() const { return _estimate; }
+
+  /// Blocks that changed the oversampling
+  uint32_t adjustments() const { return _adjustments; }
+
+private:
+  static constexpr size_t CHANNELS = 3;
+
+  Status _applyBounds(BME280& device);
+  Status _finishBlock(BME280& device);
+
+  AdaptiveOversamplingConfig _config;
+  NoiseEstimate _estimate;
+  int32_t _previous[CHANNELS] = {};
+  uint64_t _sumSqDiff[CHANNELS] = {};
+  uint16_t _samples = 0;
+  bool _skipNext = false;
+  bool _boundsApplied = false;  // Settings clamped into [min, max] since configure()
+  uint32_t _adjustments = 0;
+};
+
+} // namespace BME280
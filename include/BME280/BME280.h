@@ -2,12 +2,17 @@
 /// @brief Main driver class for BME280
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include "BME280/Status.h"
 #include "BME280/Config.h"
 #include "BME280/CommandTable.h"
+#include "BME280/Compensation.h"
+#include "BME280/Instrumentation.h"
+#include "BME280/SpscRing.h"
 #include "BME280/Version.h"
+#include "BME280/WindowStats.h"
 
 namespace BME280 {
 
@@ -19,51 +24,20 @@ enum class DriverState : uint8_t {
   OFFLINE    ///< consecutiveFailures >= offlineThreshold
 };
 
+/// Measurement time estimate variant (datasheet section 9.1)
+enum class MeasurementTime : uint8_t {
+  TYPICAL, ///< Typical conversion time
+  MAX      ///< Maximum conversion time
+};
+
+#if BME280_ENABLE_FLOAT_API
 /// Measurement result (float)
 struct Measurement {
   float temperatureC = 0.0f; ///< Temperature in Celsius
   float pressurePa = 0.0f;   ///< Pressure in Pascals
   float humidityPct = 0.0f;  ///< Relative humidity in percent
 };
-
-/// Raw ADC values
-struct RawSample {
-  int32_t adcT = 0; ///< Raw temperature ADC (20-bit)
-  int32_t adcP = 0; ///< Raw pressure ADC (20-bit)
-  int32_t adcH = 0; ///< Raw humidity ADC (16-bit)
-};
-
-/// Fixed-point compensated values (no float)
-struct CompensatedSample {
-  int32_t tempC_x100 = 0;        ///< Temperature * 100 (e.g., 2534 = 25.34 degC)
-  uint32_t pressurePa = 0;       ///< Pressure in Pa
-  uint32_t humidityPct_x1024 = 0; ///< Humidity * 1024 (Q22.10 format)
-};
-
-/// Cached calibration coefficients from the device
-struct Calibration {
-  // Temperature
-  uint16_t digT1 = 0;
-  int16_t digT2 = 0;
-  int16_t digT3 = 0;
-  // Pressure
-  uint16_t digP1 = 0;
-  int16_t digP2 = 0;
-  int16_t digP3 = 0;
-  int16_t digP4 = 0;
-  int16_t digP5 = 0;
-  int16_t digP6 = 0;
-  int16_t digP7 = 0;
-  int16_t digP8 = 0;
-  int16_t digP9 = 0;
-  // Humidity
-  uint8_t digH1 = 0;
-  int16_t digH2 = 0;
-  uint8_t digH3 = 0;
-  int16_t digH4 = 0;
-  int16_t digH5 = 0;
-  int8_t digH6 = 0;
-};
+#endif
 
 /// Raw calibration register blocks
 struct CalibrationRaw {
@@ -72,7 +46,33 @@ struct CalibrationRaw {
   uint8_t h[cmd::REG_CALIB_H_LEN] = {};
 };
 
+/// Register/value pair for batched writes
+struct RegPair {
+  uint8_t reg = 0;   ///< Register address
+  uint8_t value = 0; ///< Value to write
+};
+
+/// Size of a serialized calibration blob
+static constexpr size_t CALIBRATION_BLOB_SIZE = 35;
+
+/// nextSampleDueMs() result when no sample is due (not a timestamp; compare first)
+static constexpr uint32_t NO_SAMPLE_DUE_MS = UINT32_MAX;
+
+/// Persistable calibration image for warm boot (see BME280::exportCalibration())
+/// Layout: [0] format version, [1..32] calibration registers 0x88..0x9F, 0xA1 and
+/// 0xE1..0xE7, [33..34] CRC-16/CCITT-FALSE over bytes 0..32 (little-endian)
+struct CalibrationBlob {
+  uint8_t data[CALIBRATION_BLOB_SIZE] = {};
+};
+
 /// BME280 driver class
+///
+/// Thread safety: an instance is not synchronized. All member functions must be
+/// called from one task (or under the caller's lock), with these exceptions:
+/// - onTransferComplete() may be called from an ISR or another task.
+/// - The consumer side of an attached SampleRing/FrameRing may run concurrently
+///   on another task or core; tick() is the only producer.
+/// Pipeline follows this contract by confining the instance to its acquisition task.
 class BME280 {
 public:
   // =========================================================================
@@ -83,13 +83,101 @@ public:
   /// @param config Configuration including transport callbacks
   /// @return Status::Ok() on success, error otherwise
   Status begin(const Config& config);
+
+  /// Initialize the driver using a previously exported calibration blob
+  /// Skips the calibration register reads; chip ID is still checked and, if
+  /// Config::calibSpotCheck is set, dig_T1 is compared against the device.
+  /// @param config Configuration including transport callbacks
+  /// @param blob Blob from exportCalibration() (e.g. restored from NVS/RTC memory)
+  /// @return Status::Ok() on success, CALIBRATION_INVALID if the blob is corrupt or stale
+  Status begin(const Config& config, const CalibrationBlob& blob);
   
   /// Process pending operations (call regularly from loop)
-  /// @param nowMs Current timestamp in milliseconds
+  /// @param nowMs Current timestamp in milliseconds, same timebase as
+  ///              Config::clockUs (or millis() when no clock is injected)
   void tick(uint32_t nowMs);
   
   /// Shutdown the driver and release resources
   void end();
+
+  /// Completion notification for transfers started via Config::i2cSubmit
+  /// Safe to call from an ISR or another task; processed on the next tick().
+  /// Not needed when Config::i2cPoll is set.
+  /// @param result Final transfer status
+  void onTransferComplete(const Status& result);
+
+  /// True while an asynchronous transfer is in flight
+  bool transferPending() const { return _asyncOp != AsyncOp::NONE; }
+
+  // =========================================================================
+  // Raw Capture
+  // =========================================================================
+
+  /// Capture raw data frames instead of compensating
+  /// While attached, tick() stores the untouched 8-byte data block and its
+  /// timestamp in buf[frameCount()] and skips decoding and compensation;
+  /// getMeasurement() is not updated. Decode later with comp::compensateFrames().
+  /// @param buf Caller-owned frame storage (must outlive the attachment)
+  /// @param capacity Number of frames in buf
+  Status attachFrameBuffer(RawFrame* buf, size_t capacity);
+
+  /// Return to compensating in tick()
+  void detachFrameBuffer();
+
+  /// Frames captured since attach or clearFrames()
+  size_t frameCount() const { return _frameCount; }
+
+  /// Mark all captured frames as consumed
+  void clearFrames();
+
+  /// Samples skipped because the frame buffer was full
+  uint32_t framesDropped() const { return _framesDropped; }
+
+  /// Capture raw data frames into an SPSC ring instead of compensating
+  /// tick() is the single producer; a consumer on another core pops frames and
+  /// compensates them (see Pipeline). Losses are counted by the ring.
+  /// Mutually exclusive with attachFrameBuffer().
+  /// @param ring Caller-owned ring (must outlive the attachment)
+  Status attachFrameRing(SpscRing<RawFrame>* ring);
+
+  /// Return to compensating in tick()
+  void detachFrameRing() { _frameRing = nullptr; }
+
+  // =========================================================================
+  // Sample Queue
+  // =========================================================================
+
+  /// Queue every compensated sample into a ring (see SampleRing)
+  /// tick() is the single producer; one consumer task may pop() concurrently.
+  /// The latest sample stays available through getMeasurement().
+  /// @param ring Caller-owned ring (must outlive the attachment)
+  Status attachSampleRing(SpscRing<TimestampedSample>* ring);
+
+  /// Stop queueing samples
+  void detachSampleRing() { _sampleRing = nullptr; }
+
+  /// Replace the software filter settings and reset its state
+  /// Applied in tick() after compensation, before window statistics and the deadband.
+  /// @return INVALID_PARAM for median taps other than OFF/3/5 or an IIR shift above 7
+  Status setSampleFilter(const SampleFilterConfig& config);
+
+  /// Current software filter settings
+  SampleFilterConfig sampleFilter() const { return _config.sampleFilter; }
+
+  /// Replace the deadband; the next sample is always delivered
+  void setDeadband(const Deadband& deadband);
+
+  /// Current deadband
+  Deadband deadband() const { return _config.deadband; }
+
+  /// Feed every compensated sample into a window aggregator from tick()
+  /// The aggregator sees all samples, including those withheld by the deadband.
+  /// Tumbling-window callbacks run inside tick().
+  /// @param stats Caller-owned aggregator (must outlive the attachment)
+  Status attachWindowStats(WindowStats* stats);
+
+  /// Stop feeding the window aggregator
+  void detachWindowStats() { _windowStats = nullptr; }
   
   // =========================================================================
   // Diagnostics
@@ -102,6 +190,10 @@ public:
   /// Attempt to recover from DEGRADED/OFFLINE state
   /// @return Status::Ok() if device now responsive, error otherwise
   Status recover();
+
+  /// Non-blocking recovery: verify chip ID, then run the beginReset() sequence
+  /// @return IN_PROGRESS if the reset was started, error otherwise
+  Status beginRecover();
   
   // =========================================================================
   // Driver State
@@ -137,6 +229,46 @@ public:
   
   /// Total success count (lifetime)
   uint32_t totalSuccess() const { return _totalSuccess; }
+
+  /// Fused reads where ctrl_meas/config did not match the driver settings
+  uint32_t configDriftCount() const { return _configDriftCount; }
+
+  /// Samples withheld by the deadband (see Config::deadband)
+  uint32_t suppressedSamples() const { return _suppressedSamples; }
+
+  /// Samples lost because the attached sample ring was full
+  uint32_t ringOverruns() const { return (_sampleRing != nullptr) ? _sampleRing->overruns() : 0; }
+
+  /// Recovery probes made by tick() (see Config::recovery)
+  uint32_t recoveryAttempts() const { return _recoveryAttempts; }
+
+  /// Automatic recoveries that brought the driver back from OFFLINE
+  uint32_t recoveries() const { return _recoveries; }
+
+  /// True while tick() has a recovery probe scheduled
+  bool recoveryScheduled() const { return _recoveryScheduled; }
+
+  /// Time of the next recovery probe (valid while recoveryScheduled())
+  uint32_t nextRecoveryMs() const { return _nextRecoveryMs; }
+
+#if BME280_ENABLE_INSTRUMENTATION
+  // =========================================================================
+  // Bus Instrumentation (BME280_ENABLE_INSTRUMENTATION)
+  // =========================================================================
+
+  /// Per-kind transaction counters and latency histogram since begin()
+  /// Covers the tracked transport only (everything after begin() has probed the chip).
+  const BusStats& busStats() const { return _busStats; }
+
+  /// Clear busStats() and the trace ring
+  void resetBusStats();
+
+  /// Copy the most recent transactions, oldest first
+  /// @param out Destination array
+  /// @param maxEntries Capacity of out
+  /// @return Entries written (at most BME280_TRACE_DEPTH)
+  size_t busTrace(BusTraceEntry* out, size_t maxEntries) const;
+#endif
   
   // =========================================================================
   // Measurement API
@@ -146,15 +278,28 @@ public:
   /// In FORCED mode: triggers measurement if idle
   /// In NORMAL mode: marks intent to read next available
   /// Returns IN_PROGRESS if measurement started, BUSY if already measuring or OFFLINE
+  /// With Config::forcedAutoRearm, returns IN_PROGRESS while a conversion is armed
   Status requestMeasurement();
 
   /// Check if measurement is ready to read
   bool measurementReady() const { return _measurementReady; }
 
+  /// True while a requested measurement has not completed yet
+  /// With Config::forcedAutoRearm the next conversion may already run while
+  /// measurementReady() is true.
+  bool measurementPending() const { return _measurementRequested && !_measurementReady; }
+
+#if BME280_ENABLE_FLOAT_API
   /// Get measurement result (float)
   /// Returns MEASUREMENT_NOT_READY if not available
   /// Clears ready flag after successful read
   Status getMeasurement(Measurement& out);
+#endif
+
+  /// Get measurement result (fixed-point, available in every build profile)
+  /// Returns MEASUREMENT_NOT_READY if not available
+  /// Clears ready flag after successful read
+  Status getMeasurement(CompensatedSample& out);
 
   /// Get raw ADC values
   Status getRawSample(RawSample& out) const;
@@ -165,8 +310,13 @@ public:
   /// Get cached calibration coefficients
   Status getCalibration(Calibration& out) const;
 
+#if BME280_ENABLE_DIAGNOSTICS
   /// Read raw calibration registers from the device
   Status readCalibrationRaw(CalibrationRaw& out);
+#endif
+
+  /// Export cached calibration as a CRC-protected blob for warm boot
+  Status exportCalibration(CalibrationBlob& out) const;
 
   // =========================================================================
   // Configuration
@@ -193,6 +343,11 @@ public:
   /// Set standby time (normal mode only)
   Status setStandby(Standby standby);
 
+  /// Apply oversampling, filter, standby and mode together
+  /// Only registers whose value changes are written, in the minimal order the
+  /// device requires (SLEEP before config, ctrl_meas after ctrl_hum).
+  Status setConfigBatch(const ConfigBatch& batch);
+
   /// Get oversampling for temperature
   Status getOversamplingT(Oversampling& out) const;
 
@@ -205,12 +360,31 @@ public:
   /// Get IIR filter coefficient
   Status getFilter(Filter& out) const;
 
+  /// Channels measured with the current oversampling
+  /// Channels set to SKIP are neither read from the device nor compensated and
+  /// report 0. Pass to comp::compensateFrames() for captured frames.
+  Channels channels() const;
+
   /// Get standby time
   Status getStandby(Standby& out) const;
 
-  /// Soft reset device
+  /// Soft reset device (blocking: polls im_update for up to 10 ms)
   Status softReset();
 
+  /// Start a non-blocking soft reset
+  /// tick() then polls im_update at most once per millisecond, reloads
+  /// calibration and re-applies the configuration, one step per call.
+  /// Measurements and setters return BUSY until the sequence finishes.
+  /// @return IN_PROGRESS if started, error otherwise
+  Status beginReset();
+
+  /// True while a beginReset()/beginRecover() sequence is running
+  bool resetPending() const { return _resetStep != ResetStep::IDLE; }
+
+  /// Result of the last non-blocking reset (IN_PROGRESS while running)
+  Status resetStatus() const { return _resetResult; }
+
+#if BME280_ENABLE_DIAGNOSTICS
   /// Read chip ID
   Status readChipId(uint8_t& id);
 
@@ -225,6 +399,7 @@ public:
 
   /// Read config register
   Status readConfig(uint8_t& value);
+#endif
 
   /// Check if device is currently measuring
   Status isMeasuring(bool& measuring);
@@ -234,27 +409,70 @@ public:
   // =========================================================================
 
   /// Estimate max measurement time based on current oversampling
-  /// Returns time in milliseconds
+  /// Includes Config::measurementMarginUs; returns time in milliseconds (rounded up)
   uint32_t estimateMeasurementTimeMs() const;
 
+  /// Estimate measurement time based on current oversampling
+  /// @param variant TYPICAL or MAX datasheet formula (no margin added)
+  /// @return Conversion time in microseconds
+  uint32_t estimateMeasurementTimeUs(MeasurementTime variant = MeasurementTime::MAX) const;
+
+  /// Timestamp at which tick() will next touch the bus for a requested sample
+  /// NORMAL: one standby period plus measurement time after the last read (or
+  /// first conversion after the mode was entered); FORCED: end of the pending
+  /// conversion. Schedulers can sleep until this time.
+  /// @return NO_SAMPLE_DUE_MS in SLEEP, before begin(), or in FORCED mode with no
+  ///         measurement requested
+  uint32_t nextSampleDueMs() const;
+
 private:
   // =========================================================================
   // Transport Wrappers
   // =========================================================================
   
-  /// Raw I2C write-read (no health tracking)
-  Status _i2cWriteReadRaw(const uint8_t* txBuf, size_t txLen, 
+  /// Raw bus write-read (no health tracking)
+  Status _busWriteReadRaw(const uint8_t* txBuf, size_t txLen, 
                           uint8_t* rxBuf, size_t rxLen);
   
-  /// Raw I2C write (no health tracking)
-  Status _i2cWriteRaw(const uint8_t* buf, size_t len);
+  /// Raw bus write (no health tracking)
+  Status _busWriteRaw(const uint8_t* buf, size_t len);
   
-  /// Tracked I2C write-read (updates health)
-  Status _i2cWriteReadTracked(const uint8_t* txBuf, size_t txLen, 
+  /// Tracked bus write-read (updates health)
+  Status _busWriteReadTracked(const uint8_t* txBuf, size_t txLen, 
                               uint8_t* rxBuf, size_t rxLen);
   
-  /// Tracked I2C write (updates health)
-  Status _i2cWriteTracked(const uint8_t* buf, size_t len);
+  /// Tracked bus write (updates health)
+  Status _busWriteTracked(const uint8_t* buf, size_t len);
+
+  /// Asynchronous operation in flight
+  enum class AsyncOp : uint8_t {
+    NONE,
+    TRIGGER,  ///< FORCED-mode ctrl_meas write
+    READ      ///< Fused status + data burst
+  };
+
+  /// Raw asynchronous submit (no health tracking)
+  Status _i2cSubmitRaw(const uint8_t* txBuf, size_t txLen,
+                       uint8_t* rxBuf, size_t rxLen);
+
+  /// Tracked asynchronous submit (submit errors update health)
+  Status _i2cSubmitTracked(AsyncOp op, const uint8_t* txBuf, size_t txLen,
+                           uint8_t* rxBuf, size_t rxLen);
+
+  /// Tracked asynchronous completion (updates health)
+  Status _i2cCompleteTracked(const Status& result);
+
+#if BME280_ENABLE_INSTRUMENTATION
+  /// Classify a transaction from its first bytes
+  BusOp _classifyRead(uint8_t reg, size_t rxLen) const;
+  BusOp _classifyWrite(const uint8_t* buf, size_t len) const;
+
+  /// Account one finished transaction in _busStats and the trace ring
+  void _recordBusOp(BusOp op, uint8_t reg, size_t bytes, uint32_t startUs, const Status& st);
+#endif
+
+  /// Check for completion via onTransferComplete() or Config::i2cPoll
+  bool _asyncPollComplete(Status& result);
   
   // =========================================================================
   // Register Access
@@ -264,8 +482,18 @@ private:
   Status readRegs(uint8_t startReg, uint8_t* buf, size_t len);
   
   /// Write registers (uses tracked path)
+  /// The device does not auto-increment on writes; sent as register/value pairs
   Status writeRegs(uint8_t startReg, const uint8_t* buf, size_t len);
 
+  /// Write register/value pairs in one transaction (uses tracked path)
+  Status writeRegPairs(const RegPair* pairs, size_t count);
+
+  /// Write register/value pairs in one transaction, e.g. writeRegPairs({{reg, v}, ...})
+  template <size_t N>
+  Status writeRegPairs(const RegPair (&pairs)[N]) {
+    return writeRegPairs(pairs, N);
+  }
+
   /// Read single register (uses tracked path)
   Status readRegister(uint8_t reg, uint8_t& value);
 
@@ -274,6 +502,15 @@ private:
 
   /// Read single register (raw path)
   Status _readRegisterRaw(uint8_t reg, uint8_t& value);
+
+  /// Set spi3w_en in 3-wire SPI mode (raw path, no-op on other buses)
+  Status _enableSpi3wRaw();
+
+  /// Register address byte for a read (SPI sets bit 7)
+  uint8_t _readAddress(uint8_t reg) const;
+
+  /// Register address byte for a write (SPI clears bit 7)
+  uint8_t _writeAddress(uint8_t reg) const;
   
   // =========================================================================
   // Health Management
@@ -283,14 +520,55 @@ private:
   /// Called ONLY from tracked transport wrappers
   Status _updateHealth(const Status& st);
 
+  // =========================================================================
+  // Clock
+  // =========================================================================
+
+  /// Microsecond clock (Config::clockUs or micros())
+  uint32_t _clockUs() const;
+  uint64_t _clockUs64() const;
+
+  /// Microseconds since the FORCED trigger; full 64-bit span with Config::clockUs
+  uint64_t _forcedElapsedUs() const;
+
+  /// Millisecond clock (Config::clockUs / 1000 or millis())
+  uint32_t _clockMs() const;
+
+  /// Current time in ms; inside tick() this is the nowMs argument
+  uint32_t _nowMs() const;
+
   // =========================================================================
   // Internal
   // =========================================================================
 
+  Status _begin(const Config& config, const CalibrationBlob* blob);
+  void _tickMeasurement(uint32_t nowMs);
+  void _tickRecovery(uint32_t nowMs);
+  uint32_t _recoveryDelayMs();
+  void _tickAsyncCompletion(uint32_t nowMs);
+  void _publishSample(uint32_t nowMs);
+  bool _passesDeadband(uint32_t nowMs) const;
+  Status _submitAsyncTrigger();
+  Status _triggerForced();
+  void _rearmForced();
+  void _tickReset(uint32_t nowMs);
+  Status _writeReset();
   Status _applyConfig();
+  Status _applySettings(Oversampling osrsT, Oversampling osrsP, Oversampling osrsH,
+                        Filter filter, Standby standby, Mode mode);
+  Status _writeSettings(uint8_t ctrlHum, uint8_t ctrlMeas, uint8_t config,
+                        bool& started);
+  uint32_t _normalPeriodMs() const;
   Status _readCalibration();
+  Status _loadCalibrationBlob(const CalibrationBlob& blob);
+  void _parseCalibration(const uint8_t* tp, uint8_t h1, const uint8_t* h);
   Status _validateCalibration();
   Status _readRawData();
+  Status _readFused(bool& busy);
+  Status _processFused(const uint8_t* buf, bool& busy);
+  Status _recoverConfigDrift();
+  uint8_t* _captureSlot();
+  void _decodeRawData(const uint8_t* data);
   Status _compensate();
   
   // =========================================================================
@@ -300,6 +578,8 @@ private:
   Config _config;
   bool _initialized = false;
   DriverState _driverState = DriverState::UNINIT;
+  bool _inTick = false;
+  uint32_t _tickNowMs = 0;
   
   // Health counters
   uint32_t _lastOkMs = 0;
@@ -308,31 +588,85 @@ private:
   uint8_t _consecutiveFailures = 0;
   uint32_t _totalFailures = 0;
   uint32_t _totalSuccess = 0;
+  uint32_t _configDriftCount = 0;
+
+  // Automatic recovery (Config::recovery)
+  bool _recoveryScheduled = false;
+  uint32_t _nextRecoveryMs = 0;
+  uint32_t _recoveryBackoffMs = 0;  // Delay before jitter
+  uint32_t _recoveryAttempts = 0;
+  uint32_t _recoveries = 0;
+  uint32_t _jitterState = 1;        // xorshift32 state, never 0
+
+  // Non-blocking reset sequence
+  enum class ResetStep : uint8_t {
+    IDLE,
+    WAIT_NVM,          ///< Polling im_update after the reset command
+    LOAD_CALIBRATION,  ///< Re-reading calibration
+    APPLY_CONFIG       ///< Re-applying the cached configuration
+  };
+  ResetStep _resetStep = ResetStep::IDLE;
+  uint32_t _resetDeadlineMs = 0;
+  uint32_t _resetNextPollMs = 0;
+  Status _resetResult = Status::Ok();
+
+  // Sample queue
+  SpscRing<TimestampedSample>* _sampleRing = nullptr;
+
+  // Window statistics
+  WindowStats* _windowStats = nullptr;
+
+  // Software filter stage
+  SampleFilter _sampleFilter;
+
+  // Deadband reference (last delivered sample)
+  bool _deliveredValid = false;
+  uint32_t _lastDeliveredMs = 0;
+  CompensatedSample _lastDelivered;
+  uint32_t _suppressedSamples = 0;
+
+  // Raw capture
+  SpscRing<RawFrame>* _frameRing = nullptr;
+  RawFrame _ringFrame;
+  RawFrame* _frames = nullptr;
+  size_t _frameCapacity = 0;
+  size_t _frameCount = 0;
+  uint32_t _framesDropped = 0;
+
+  // Asynchronous transport
+  AsyncOp _asyncOp = AsyncOp::NONE;
+  std::atomic<bool> _asyncDone{false};
+  Status _asyncResult = Status::Ok();
+  uint8_t _asyncTx[2] = {};
+  uint8_t _asyncRx[cmd::FUSED_LEN] = {};
+
+#if BME280_ENABLE_INSTRUMENTATION
+  // Bus instrumentation
+  BusStats _busStats;
+  BusTraceEntry _trace[BME280_TRACE_DEPTH];
+  uint32_t _traceCount = 0;   // Entries ever recorded; next slot is _traceCount % depth
+  BusOp _asyncBusOp = BusOp::REGISTER_READ;
+  uint8_t _asyncBusReg = 0;
+  size_t _asyncBusBytes = 0;
+  uint32_t _asyncStartUs = 0;
+#endif
+
+  // Shadow copies of the settled ctrl_hum/ctrl_meas/config register values
+  bool _shadowValid = false;
+  uint8_t _shadowCtrlHum = 0;
+  uint8_t _shadowCtrlMeas = 0;
+  uint8_t _shadowConfig = 0;
 
   // Calibration data
-  uint16_t _digT1 = 0;
-  int16_t _digT2 = 0;
-  int16_t _digT3 = 0;
-  uint16_t _digP1 = 0;
-  int16_t _digP2 = 0;
-  int16_t _digP3 = 0;
-  int16_t _digP4 = 0;
-  int16_t _digP5 = 0;
-  int16_t _digP6 = 0;
-  int16_t _digP7 = 0;
-  int16_t _digP8 = 0;
-  int16_t _digP9 = 0;
-  uint8_t _digH1 = 0;
-  int16_t _digH2 = 0;
-  uint8_t _digH3 = 0;
-  int16_t _digH4 = 0;
-  int16_t _digH5 = 0;
-  int8_t _digH6 = 0;
+  Calibration _calib;
 
   // Measurement state
   bool _measurementRequested = false;
   bool _measurementReady = false;
+  bool _triggerPending = false;      // FORCED trigger write failed; tick() retries it
   uint32_t _measurementStartMs = 0;
+  uint64_t _measurementStartUs = 0;  // Config::clockUs value, or micros()
+  uint32_t _nextSampleDueMs = 0;
   int32_t _tFine = 0;
   RawSample _rawSample;
   CompensatedSample _compSample;
@@ -45,13 +45,32 @@ static constexpr uint8_t REG_HUM_LSB = 0xFE;
 
 static constexpr uint8_t REG_DATA_START = REG_PRESS_MSB;
 static constexpr uint8_t DATA_LEN = 8;
+static constexpr uint8_t DATA_IDX_PRESS = 0;       // 0xF7..0xF9
+static constexpr uint8_t DATA_IDX_TEMP = 3;        // 0xFA..0xFC
+static constexpr uint8_t DATA_IDX_HUM = 6;         // 0xFD..0xFE
+
+// A skipped channel reads back as 0x80000 (press/temp) or 0x8000 (hum)
+static constexpr uint8_t SKIP_MSB = 0x80;
+
+// ============================================================================
+// Fused Status + Data Burst (0xF3..0xFE)
+// ============================================================================
+
+// One burst covers status, ctrl_meas, config, reserved 0xF6 and the data block
+static constexpr uint8_t REG_FUSED_START = REG_STATUS;
+static constexpr uint8_t FUSED_LEN = 12;
+static constexpr uint8_t FUSED_IDX_STATUS = 0;     // 0xF3
+static constexpr uint8_t FUSED_IDX_CTRL_MEAS = 1;  // 0xF4
+static constexpr uint8_t FUSED_IDX_CONFIG = 2;     // 0xF5
+static constexpr uint8_t FUSED_IDX_DATA = 4;       // 0xF7..0xFE
 
 // ============================================================================
 // Calibration Registers
 // ============================================================================
 
-static constexpr uint8_t REG_CALIB_TP_START = 0x88;  // T1..T3, P1..P9 (26 bytes)
+static constexpr uint8_t REG_CALIB_TP_START = 0x88;  // T1..T3, P1..P9, 0xA0, H1 (26 bytes)
 static constexpr uint8_t REG_CALIB_TP_LEN = 26;
+static constexpr uint8_t CALIB_TP_IDX_H1 = 25;       // H1 (0xA1) is the last byte of the block
 static constexpr uint8_t REG_CALIB_H1 = 0xA1;        // H1 (1 byte)
 static constexpr uint8_t REG_CALIB_H_START = 0xE1;   // H2..H6 (7 bytes)
 static constexpr uint8_t REG_CALIB_H_LEN = 7;
@@ -111,6 +130,10 @@ static constexpr uint8_t MASK_CONFIG_T_SB = 0xE0;
 static constexpr uint8_t MASK_CONFIG_FILTER = 0x1C;
 static constexpr uint8_t MASK_CONFIG_SPI3W_EN = 0x01;
 
+// SPI control byte: bit 7 selects read (1) or write (0), bits 6:0 address
+static constexpr uint8_t SPI_READ_BIT = 0x80;
+static constexpr uint8_t SPI_WRITE_MASK = 0x7F;
+
 // ============================================================================
 // Bit Positions
 // ============================================================================
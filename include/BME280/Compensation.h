@@ -0,0 +1,183 @@
+/// @file Compensation.h
+/// @brief Datasheet compensation formulas with compile-time backend selection
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/Features.h"
+#include "BME280/Status.h"
+
+/// Compensation backends (select with -DBME280_COMPENSATION=...)
+#define BME280_COMPENSATION_INT64 0  ///< Datasheet 64-bit integer pressure (reference)
+#define BME280_COMPENSATION_INT32 1  ///< Datasheet 32-bit integer pressure (no int64 math)
+#define BME280_COMPENSATION_FLOAT 2  ///< Single-precision float (FPU cores)
+
+#ifndef BME280_COMPENSATION
+#define BME280_COMPENSATION BME280_COMPENSATION_INT64
+#endif
+
+#if BME280_COMPENSATION != BME280_COMPENSATION_INT64 && \
+    BME280_COMPENSATION != BME280_COMPENSATION_INT32 && \
+    BME280_COMPENSATION != BME280_COMPENSATION_FLOAT
+#error "BME280_COMPENSATION must be INT64, INT32 or FLOAT"
+#endif
+
+namespace BME280 {
+
+/// Raw ADC values
+struct RawSample {
+  int32_t adcT = 0; ///< Raw temperature ADC (20-bit)
+  int32_t adcP = 0; ///< Raw pressure ADC (20-bit)
+  int32_t adcH = 0; ///< Raw humidity ADC (16-bit)
+};
+
+/// Fixed-point compensated values (no float)
+struct CompensatedSample {
+  int32_t tempC_x100 = 0;        ///< Temperature * 100 (e.g., 2534 = 25.34 degC)
+  uint32_t pressurePa = 0;       ///< Pressure in Pa
+  uint32_t humidityPct_x1024 = 0; ///< Humidity * 1024 (Q22.10 format)
+};
+
+/// Size of the burst data block 0xF7..0xFE (press, temp, hum)
+static constexpr size_t RAW_FRAME_DATA_LEN = 8;
+
+/// Undecoded data block as captured by BME280::attachFrameBuffer()
+struct RawFrame {
+  uint32_t timestampMs = 0;                 ///< tick() time of the read
+  uint8_t data[RAW_FRAME_DATA_LEN] = {};    ///< Registers 0xF7..0xFE, as read
+};
+
+/// Cached calibration coefficients from the device
+struct Calibration {
+  // Temperature
+  uint16_t digT1 = 0;
+  int16_t digT2 = 0;
+  int16_t digT3 = 0;
+  // Pressure
+  uint16_t digP1 = 0;
+  int16_t digP2 = 0;
+  int16_t digP3 = 0;
+  int16_t digP4 = 0;
+  int16_t digP5 = 0;
+  int16_t digP6 = 0;
+  int16_t digP7 = 0;
+  int16_t digP8 = 0;
+  int16_t digP9 = 0;
+  // Humidity
+  uint8_t digH1 = 0;
+  int16_t digH2 = 0;
+  uint8_t digH3 = 0;
+  int16_t digH4 = 0;
+  int16_t digH5 = 0;
+  int8_t digH6 = 0;
+};
+
+/// Calibration with coefficient-derived constants precomputed for batch processing
+/// Build with comp::prepareCalibration(); contents are an implementation detail.
+struct PreparedCalibration {
+  Calibration calib;    ///< Source coefficients
+  // Temperature
+  int32_t t1 = 0;       ///< dig_T1
+  int32_t t1x2 = 0;     ///< dig_T1 << 1
+  int32_t t2 = 0;       ///< dig_T2
+  int32_t t3 = 0;       ///< dig_T3
+  // Pressure (64-bit backend)
+  int64_t p1 = 0;       ///< dig_P1
+  int64_t p2s12 = 0;    ///< dig_P2 << 12
+  int64_t p3 = 0;       ///< dig_P3
+  int64_t p4s35 = 0;    ///< dig_P4 << 35
+  int64_t p5s17 = 0;    ///< dig_P5 << 17
+  int64_t p6 = 0;       ///< dig_P6
+  int64_t p7s4 = 0;     ///< dig_P7 << 4
+  int64_t p8 = 0;       ///< dig_P8
+  int64_t p9 = 0;       ///< dig_P9
+  // Humidity
+  int32_t h1 = 0;       ///< dig_H1
+  int32_t h2 = 0;       ///< dig_H2
+  int32_t h3 = 0;       ///< dig_H3
+  int32_t h4s20 = 0;    ///< dig_H4 << 20
+  int32_t h5 = 0;       ///< dig_H5
+  int32_t h6 = 0;       ///< dig_H6
+};
+
+namespace comp {
+
+/// Decode the 0xF7..0xFE data block into raw ADC values
+/// @param data RAW_FRAME_DATA_LEN bytes starting at press_msb
+/// @param out Raw ADC values
+void decodeRaw(const uint8_t* data, RawSample& out);
+
+/// Decode a captured frame into raw ADC values
+inline void decodeFrame(const RawFrame& frame, RawSample& out) {
+  decodeRaw(frame.data, out);
+}
+
+/// Precompute coefficient-derived constants for compensateBatch()
+/// @param calib Calibration coefficients
+/// @param out Prepared calibration
+void prepareCalibration(const Calibration& calib, PreparedCalibration& out);
+
+/// Compensate an array of raw samples with the BME280_COMPENSATION backend
+/// Stateless and bit-exact with compensate() per sample. Samples are processed in
+/// chunks of structure-of-arrays loops; the temperature stage is pure int32 and
+/// vectorizes on SIMD targets.
+/// @param prep Prepared calibration
+/// @param in Raw samples
+/// @param out Compensated samples (may not alias in)
+/// @param n Number of samples
+/// @param channels Channels to compensate; the others report 0
+/// @return COMPENSATION_ERROR (detail = failed sample count) if any pressure divisor
+///         was zero; those samples report 0 Pa
+Status compensateBatch(const PreparedCalibration& prep, const RawSample* in,
+                       CompensatedSample* out, size_t n,
+                       Channels channels = Channels::TPH);
+
+/// Decode and compensate an array of captured frames (see compensateBatch())
+/// @param prep Prepared calibration
+/// @param frames Captured frames
+/// @param out Compensated samples
+/// @param n Number of frames
+/// @param channels Channels to compensate; the others report 0
+/// @return COMPENSATION_ERROR (detail = failed frame count) if any pressure divisor
+///         was zero
+Status compensateFrames(const PreparedCalibration& prep, const RawFrame* frames,
+                        CompensatedSample* out, size_t n,
+                        Channels channels = Channels::TPH);
+
+/// Convenience overload that prepares the calibration first
+Status compensateBatch(const Calibration& calib, const RawSample* in,
+                       CompensatedSample* out, size_t n,
+                       Channels channels = Channels::TPH);
+
+/// Compensate with the backend selected by BME280_COMPENSATION
+/// @param calib Calibration coefficients
+/// @param raw Raw ADC values
+/// @param out Compensated values
+/// @param tFine Fine temperature shared by the pressure/humidity formulas
+/// @param channels Channels to compensate; skipped or compiled-out channels report 0
+/// @return COMPENSATION_ERROR if the pressure divisor is zero
+Status compensate(const Calibration& calib, const RawSample& raw,
+                  CompensatedSample& out, int32_t& tFine,
+                  Channels channels = Channels::TPH);
+
+/// Datasheet 64-bit integer backend (reference; bit-exact with previous releases)
+Status compensateInt64(const Calibration& calib, const RawSample& raw,
+                       CompensatedSample& out, int32_t& tFine,
+                       Channels channels = Channels::TPH);
+
+/// Datasheet 32-bit integer backend
+/// Temperature and humidity are bit-exact with compensateInt64(); pressure stays
+/// within +/-6 Pa of it over 300..1100 hPa and -40..85 degC (usually +/-1 Pa).
+Status compensateInt32(const Calibration& calib, const RawSample& raw,
+                       CompensatedSample& out, int32_t& tFine,
+                       Channels channels = Channels::TPH);
+
+/// Single-precision float backend (datasheet floating-point formulas)
+/// Within +/-0.01 degC, +/-2 Pa and +/-0.012 %RH (12 LSB of Q22.10) of
+/// compensateInt64().
+Status compensateFloat(const Calibration& calib, const RawSample& raw,
+                       CompensatedSample& out, int32_t& tFine,
+                       Channels channels = Channels::TPH);
+
+} // namespace comp
+} // namespace BME280
@@ -4,6 +4,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include "BME280/Compensation.h"
+#include "BME280/Features.h"
+#include "BME280/SampleFilter.h"
 #include "BME280/Status.h"
 
 namespace BME280 {
@@ -31,6 +34,102 @@ using I2cWriteReadFn = Status (*)(uint8_t addr, const uint8_t* txData, size_t tx
                                   uint8_t* rxData, size_t rxLen, uint32_t timeoutMs,
                                   void* user);
 
+/// SPI write callback signature (chip select held low for the whole buffer)
+/// @param data     Pointer to data to write (control byte first)
+/// @param len      Number of bytes to write
+/// @param timeoutMs Maximum time to wait for completion
+/// @param user     User context pointer passed through from Config
+/// @return Status indicating success or failure
+using SpiWriteFn = Status (*)(const uint8_t* data, size_t len, uint32_t timeoutMs,
+                              void* user);
+
+/// SPI write-then-read callback signature (chip select held low across both phases)
+/// In 3-wire mode the callback turns the SDI line around between the phases.
+/// @param txData   Pointer to data to write (control byte first)
+/// @param txLen    Number of bytes to write
+/// @param rxData   Pointer to buffer for read data
+/// @param rxLen    Number of bytes to read
+/// @param timeoutMs Maximum time to wait for completion
+/// @param user     User context pointer passed through from Config
+/// @return Status indicating success or failure
+using SpiWriteReadFn = Status (*)(const uint8_t* txData, size_t txLen,
+                                  uint8_t* rxData, size_t rxLen, uint32_t timeoutMs,
+                                  void* user);
+
+/// Asynchronous transfer descriptor: write txData, then read rxLen bytes
+struct I2cTransfer {
+  uint8_t addr = 0;              ///< I2C device address (7-bit)
+  const uint8_t* txData = nullptr; ///< Data to write (register address first)
+  size_t txLen = 0;              ///< Number of bytes to write
+  uint8_t* rxData = nullptr;     ///< Read buffer (nullptr for write-only)
+  size_t rxLen = 0;              ///< Number of bytes to read (0 for write-only)
+  uint32_t timeoutMs = 0;        ///< Maximum time for the transfer
+};
+
+/// Asynchronous submit callback signature
+/// Starts the transfer and returns immediately. Buffers stay valid until completion.
+/// @param xfer     Transfer descriptor
+/// @param user     User context pointer passed through from Config
+/// @return IN_PROGRESS when queued (report completion via BME280::onTransferComplete()
+///         or Config::i2cPoll), OK if already complete, error otherwise
+using I2cSubmitFn = Status (*)(const I2cTransfer& xfer, void* user);
+
+/// Asynchronous poll callback signature
+/// @param user     User context pointer passed through from Config
+/// @return IN_PROGRESS while the submitted transfer runs, final Status when done
+using I2cPollFn = Status (*)(void* user);
+
+/// Clock callback signature
+/// @param user     User context pointer passed through from Config
+/// @return Monotonic time in microseconds (64-bit, e.g. esp_timer_get_time())
+using ClockUsFn = uint64_t (*)(void* user);
+
+/// Sample callback signature (called from tick() for each delivered sample)
+/// @param sample   Compensated sample
+/// @param nowMs    tick() time of the readout
+/// @param user     User context pointer passed through from Config
+using SampleFn = void (*)(const CompensatedSample& sample, uint32_t nowMs, void* user);
+
+/// Change detection for sample delivery
+/// A sample is delivered (measurementReady(), sample ring, Config::sampleCallback)
+/// when any channel moved by at least its band since the last delivered sample, or
+/// when maxSilenceMs has passed since then. A band of 0 ignores the channel; all
+/// fields 0 (default) delivers every sample.
+struct Deadband {
+  uint32_t tempC_x100 = 0;        ///< Temperature band, degC * 100
+  uint32_t pressurePa = 0;        ///< Pressure band, Pa
+  uint32_t humidityPct_x1024 = 0; ///< Humidity band, %RH * 1024
+  uint32_t maxSilenceMs = 0;      ///< Heartbeat: deliver at least this often (0: never forced)
+
+  /// True if any field is set
+  bool active() const {
+    return tempC_x100 != 0 || pressurePa != 0 || humidityPct_x1024 != 0 || maxSilenceMs != 0;
+  }
+};
+
+/// Longest recovery backoff (RecoveryPolicy::maxMs), one day
+static constexpr uint32_t RECOVERY_MAX_BACKOFF_MS = 86400000;
+
+/// Automatic recovery from OFFLINE, driven by tick()
+/// While OFFLINE, tick() probes the chip ID with one single-byte read after a
+/// backoff delay. The delay starts at initialMs, doubles after each failed probe up
+/// to maxMs, and is spread by +/- jitterPct percent so that sensors on one bus do
+/// not retry in step. A successful probe writes the cached configuration again (the
+/// device may have lost power) and returns the driver to READY.
+struct RecoveryPolicy {
+  bool enabled = false;      ///< Probe from tick() while OFFLINE
+  uint32_t initialMs = 100;  ///< Delay before the first probe (> 0)
+  uint32_t maxMs = 30000;    ///< Backoff cap (initialMs..RECOVERY_MAX_BACKOFF_MS)
+  uint8_t jitterPct = 25;    ///< Random spread of each delay, 0..100 percent
+};
+
+/// Bus the device is wired to
+enum class BusType : uint8_t {
+  I2C = 0,       ///< I2C (i2cWrite/i2cWriteRead)
+  SPI_4WIRE = 1, ///< SPI mode 0/3 with separate SDI/SDO
+  SPI_3WIRE = 2  ///< SPI with bidirectional SDI (sets spi3w_en)
+};
+
 /// Oversampling settings
 enum class Oversampling : uint8_t {
   SKIP = 0,  ///< Measurement skipped
@@ -69,27 +168,78 @@ enum class Standby : uint8_t {
   MS_20 = 7    ///< 20 ms
 };
 
+/// Default oversampling for a channel that may be compiled out (see Features.h)
+static constexpr Oversampling DEFAULT_OSRS_P =
+    BME280_ENABLE_PRESSURE ? Oversampling::X1 : Oversampling::SKIP;
+static constexpr Oversampling DEFAULT_OSRS_H =
+    BME280_ENABLE_HUMIDITY ? Oversampling::X1 : Oversampling::SKIP;
+
+/// Measurement settings applied together by BME280::setConfigBatch()
+struct ConfigBatch {
+  Oversampling osrsT = Oversampling::X1; ///< Temperature oversampling
+  Oversampling osrsP = DEFAULT_OSRS_P;   ///< Pressure oversampling (SKIP if compiled out)
+  Oversampling osrsH = DEFAULT_OSRS_H;   ///< Humidity oversampling (SKIP if compiled out)
+  Filter filter = Filter::OFF;           ///< IIR filter coefficient
+  Standby standby = Standby::MS_125;     ///< Standby time (normal mode)
+  Mode mode = Mode::FORCED;              ///< Operating mode
+};
+
 /// Configuration for BME280 driver
 struct Config {
-  // === I2C Transport (required) ===
+  // === I2C Transport (required for BusType::I2C) ===
   I2cWriteFn i2cWrite = nullptr;        ///< I2C write function pointer
   I2cWriteReadFn i2cWriteRead = nullptr; ///< I2C write-read function pointer
   void* i2cUser = nullptr;               ///< User context for callbacks
   
+  // === SPI Transport (bus = SPI_4WIRE / SPI_3WIRE) ===
+  BusType bus = BusType::I2C;            ///< Bus selection
+  SpiWriteFn spiWrite = nullptr;         ///< SPI write function pointer
+  SpiWriteReadFn spiWriteRead = nullptr; ///< SPI write-read function pointer
+  void* spiUser = nullptr;               ///< User context for SPI callbacks
+
+  // === Asynchronous Transport (optional) ===
+  I2cSubmitFn i2cSubmit = nullptr;       ///< Async submit; tick() trigger/read use it when set
+  I2cPollFn i2cPoll = nullptr;           ///< Async completion poll (or use onTransferComplete())
+
   // === Device Settings ===
-  uint8_t i2cAddress = 0x76;             ///< 0x76 (SDO=GND) or 0x77 (SDO=VDD)
-  uint32_t i2cTimeoutMs = 50;            ///< I2C transaction timeout in ms
+  uint8_t i2cAddress = 0x76;             ///< 0x76 (SDO=GND) or 0x77 (SDO=VDD); I2C only
+  uint32_t i2cTimeoutMs = 50;            ///< Bus transaction timeout in ms (I2C and SPI)
 
   // === Measurement Settings ===
   Oversampling osrsT = Oversampling::X1; ///< Temperature oversampling
-  Oversampling osrsP = Oversampling::X1; ///< Pressure oversampling
-  Oversampling osrsH = Oversampling::X1; ///< Humidity oversampling
+  Oversampling osrsP = DEFAULT_OSRS_P;   ///< Pressure oversampling (SKIP if compiled out)
+  Oversampling osrsH = DEFAULT_OSRS_H;   ///< Humidity oversampling (SKIP if compiled out)
   Filter filter = Filter::OFF;           ///< IIR filter coefficient
   Standby standby = Standby::MS_125;     ///< Standby time (normal mode)
   Mode mode = Mode::FORCED;              ///< Operating mode
+
+  // === Clock (optional) ===
+  ClockUsFn clockUs = nullptr;           ///< Microsecond clock; nullptr uses micros()/millis()
+  void* clockUser = nullptr;             ///< User context for clock callback
+
+  // === Timing ===
+  uint32_t measurementMarginUs = 1000;   ///< Extra wait added to the max conversion time
+
+  // === Forced Mode ===
+  bool forcedAutoRearm = false;          ///< Re-trigger FORCED conversions right after each readout
+
+  // === Software Filter ===
+  SampleFilterConfig sampleFilter;       ///< Median + IIR after compensation (default: off)
+
+  // === Sample Delivery ===
+  Deadband deadband;                     ///< Suppress samples within the bands (default: off)
+  SampleFn sampleCallback = nullptr;     ///< Called from tick() for each delivered sample
+  void* sampleUser = nullptr;            ///< User context for sampleCallback
+
+  // === Bus Usage ===
+  bool fusedRead = false;                ///< Read status + data (0xF3..0xFE) in one burst
+
+  // === Warm Boot ===
+  bool calibSpotCheck = true;            ///< Compare dig_T1 with the device when begin() gets a blob
   
   // === Health Tracking ===
   uint8_t offlineThreshold = 5;          ///< Consecutive failures before OFFLINE state
+  RecoveryPolicy recovery;               ///< tick()-driven recovery from OFFLINE (default: off)
 };
 
 } // namespace BME280
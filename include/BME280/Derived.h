@@ -0,0 +1,87 @@
+/// @file Derived.h
+/// @brief Fixed-point derived quantities (altitude, sea-level pressure, dew point,
+///        absolute humidity) from compensated samples
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/Compensation.h"
+#include "BME280/Status.h"
+
+namespace BME280 {
+
+/// Standard sea-level pressure (ICAO)
+static constexpr uint32_t STANDARD_SEA_LEVEL_PA = 101325;
+
+/// Reference values for derive()
+struct DerivedConfig {
+  uint32_t seaLevelPa = STANDARD_SEA_LEVEL_PA; ///< Reference for altitudeCm
+  int32_t stationAltitudeCm = 0;               ///< Sensor altitude for seaLevelPa
+};
+
+/// Quantities derived from one CompensatedSample
+struct DerivedSample {
+  int32_t altitudeCm = 0;          ///< Altitude above DerivedConfig::seaLevelPa, in cm
+  uint32_t seaLevelPa = 0;         ///< Pressure reduced to sea level, in Pa
+  int32_t dewPointC_x100 = 0;      ///< Dew point * 100 (degC)
+  uint32_t absHumidity_mgm3 = 0;   ///< Absolute humidity in mg/m^3
+};
+
+/// Table-based approximations without float or libm
+/// Tables (2.4 KB flash) are linear-interpolated and generated by
+/// scripts/generate_derived_tables.py. Error bounds are against the same formulas
+/// evaluated in double precision:
+/// - altitude (barometric formula): +/-13 cm over 300..1100 hPa
+/// - sea-level pressure: +/-25 ppm (about +/-1 Pa at 1013 hPa) for -500..9900 m
+/// - dew point (Magnus over water): +/-0.03 degC for -40..85 degC, 1..100 %RH
+/// - absolute humidity: +/-0.2 % above 0.5 g/m^3, +/-1 mg/m^3 below
+/// The Magnus approximation itself is within 0.35 degC of the WMO reference.
+namespace derived {
+
+/// Altitude from pressure (international barometric formula)
+/// @param pressurePa Measured pressure
+/// @param seaLevelPa Reference sea-level pressure
+/// @return Altitude in cm; 0 if either pressure is 0. Ratios outside 0.25..1.25
+///         are clamped.
+int32_t altitudeCm(uint32_t pressurePa, uint32_t seaLevelPa = STANDARD_SEA_LEVEL_PA);
+
+/// Reduce station pressure to sea level (inverse of altitudeCm())
+/// @param pressurePa Measured pressure
+/// @param altitudeCm Station altitude, clamped to -512..9973 m
+/// @return Sea-level pressure in Pa; 0 if pressurePa is 0
+uint32_t seaLevelPressurePa(uint32_t pressurePa, int32_t altitudeCm);
+
+/// Saturation vapor pressure over water (Magnus)
+/// @param tempC_x100 Temperature * 100, clamped to -60..88 degC
+/// @return Saturation vapor pressure in mPa
+uint32_t saturationVaporPressure_mPa(int32_t tempC_x100);
+
+/// Dew point (Magnus, via the inverse saturation table)
+/// @param tempC_x100 Temperature * 100
+/// @param humidityPct_x1024 Relative humidity * 1024
+/// @return Dew point * 100; floors at -60 degC (including 0 %RH)
+int32_t dewPointC_x100(int32_t tempC_x100, uint32_t humidityPct_x1024);
+
+/// Absolute humidity (water vapor density)
+/// @param tempC_x100 Temperature * 100
+/// @param humidityPct_x1024 Relative humidity * 1024
+/// @return Absolute humidity in mg/m^3
+uint32_t absoluteHumidity_mgm3(int32_t tempC_x100, uint32_t humidityPct_x1024);
+
+/// Derive all quantities for one sample
+void derive(const CompensatedSample& in, DerivedSample& out,
+            const DerivedConfig& config = DerivedConfig());
+
+/// Derive all quantities for an array of samples
+/// Bit-exact with the per-sample functions; the sea-level reciprocal is computed
+/// once per call instead of once per sample.
+/// @param in Compensated samples
+/// @param out Derived samples
+/// @param n Number of samples
+/// @param config Reference values
+/// @return INVALID_PARAM if a buffer is null
+Status derive(const CompensatedSample* in, DerivedSample* out, size_t n,
+              const DerivedConfig& config = DerivedConfig());
+
+} // namespace derived
+} // namespace BME280
@@ -0,0 +1,80 @@
+/// @file Features.h
+/// @brief Compile-time channel and feature selection
+#pragma once
+
+#include <cstdint>
+
+/// Build with -DBME280_ENABLE_PRESSURE=0 to strip the pressure channel
+#ifndef BME280_ENABLE_PRESSURE
+#define BME280_ENABLE_PRESSURE 1
+#endif
+
+/// Build with -DBME280_ENABLE_HUMIDITY=0 to strip the humidity channel
+#ifndef BME280_ENABLE_HUMIDITY
+#define BME280_ENABLE_HUMIDITY 1
+#endif
+
+/// Build with -DBME280_ENABLE_INSTRUMENTATION=1 for per-transaction bus statistics
+#ifndef BME280_ENABLE_INSTRUMENTATION
+#define BME280_ENABLE_INSTRUMENTATION 0
+#endif
+
+/// Transactions kept in the instrumentation trace ring
+#ifndef BME280_TRACE_DEPTH
+#define BME280_TRACE_DEPTH 16
+#endif
+
+/// Build with -DBME280_MINIMAL=1 for the minimal-footprint profile: compact Status,
+/// no float API and no raw-register diagnostics (each can be re-enabled below)
+#ifndef BME280_MINIMAL
+#define BME280_MINIMAL 0
+#endif
+
+/// Status message strings (0: Status holds code and a 16-bit detail only)
+#ifndef BME280_ENABLE_STATUS_MESSAGES
+#define BME280_ENABLE_STATUS_MESSAGES (!BME280_MINIMAL)
+#endif
+
+/// Float Measurement and getMeasurement(Measurement&)
+#ifndef BME280_ENABLE_FLOAT_API
+#define BME280_ENABLE_FLOAT_API (!BME280_MINIMAL)
+#endif
+
+/// readCalibrationRaw() and the raw register getters (readChipId(), readStatus(), ...)
+#ifndef BME280_ENABLE_DIAGNOSTICS
+#define BME280_ENABLE_DIAGNOSTICS (!BME280_MINIMAL)
+#endif
+
+namespace BME280 {
+
+/// Measurement channel set (temperature is always measured; it feeds t_fine)
+enum class Channels : uint8_t {
+  T = 0x01,   ///< Temperature only
+  TP = 0x03,  ///< Temperature and pressure
+  TH = 0x05,  ///< Temperature and humidity
+  TPH = 0x07  ///< All channels
+};
+
+/// Channel bits
+static constexpr uint8_t CHANNEL_PRESSURE = 0x02;
+static constexpr uint8_t CHANNEL_HUMIDITY = 0x04;
+
+/// Channels compiled into this build
+static constexpr Channels COMPILED_CHANNELS = static_cast<Channels>(
+    0x01 | (BME280_ENABLE_PRESSURE ? CHANNEL_PRESSURE : 0) |
+    (BME280_ENABLE_HUMIDITY ? CHANNEL_HUMIDITY : 0));
+
+/// True if pressure is compiled in and part of the set
+/// Constant-false when stripped, so guarded code is removed by the compiler.
+inline constexpr bool hasPressure(Channels channels) {
+  return BME280_ENABLE_PRESSURE != 0 &&
+         (static_cast<uint8_t>(channels) & CHANNEL_PRESSURE) != 0;
+}
+
+/// True if humidity is compiled in and part of the set
+inline constexpr bool hasHumidity(Channels channels) {
+  return BME280_ENABLE_HUMIDITY != 0 &&
+         (static_cast<uint8_t>(channels) & CHANNEL_HUMIDITY) != 0;
+}
+
+} // namespace BME280
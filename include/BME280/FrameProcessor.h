@@ -0,0 +1,61 @@
+/// @file FrameProcessor.h
+/// @brief Raw-frame processing stage: batch compensation, software filter, derived
+///        quantities (the processing side of Pipeline, usable on any platform)
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/Compensation.h"
+#include "BME280/Derived.h"
+#include "BME280/SampleFilter.h"
+#include "BME280/SpscRing.h"
+#include "BME280/Status.h"
+
+namespace BME280 {
+
+/// Pops raw frames from a ring and turns them into delivered samples
+///
+/// Each process() call drains up to BATCH frames, compensates them in one batch
+/// with a PreparedCalibration snapshot, runs the SampleFilter on every good sample
+/// in ring order and, if requested, derives altitude, sea-level pressure, dew point
+/// and absolute humidity. This is what tick() does for a live sample, minus the
+/// deadband and window statistics. Frames that fail compensation are counted in
+/// errors() and dropped; they do not reach the filter.
+///
+/// Call process() from the ring's consumer side only.
+class FrameProcessor {
+public:
+  /// Frames handled per process() call
+  static constexpr size_t BATCH = 16;
+
+  /// Snapshot the calibration and filter settings and reset all state
+  /// @param calib Device calibration (BME280::getCalibration())
+  /// @param channels Channels to compensate; the others report 0
+  /// @param filter Software filter settings (default: pass-through)
+  void configure(const Calibration& calib, Channels channels,
+                 const SampleFilterConfig& filter = SampleFilterConfig());
+
+  /// Pop, compensate, filter and optionally derive up to maxCount frames
+  /// @param ring Raw-frame ring to drain
+  /// @param out Delivered samples, in ring order
+  /// @param derived Derived quantities per delivered sample; nullptr to skip
+  /// @param maxCount Capacity of out (and derived); at most BATCH frames are popped
+  /// @return Number of samples written to out
+  size_t process(SpscRing<RawFrame>& ring, TimestampedSample* out, DerivedSample* derived,
+                 size_t maxCount);
+
+  /// Reference values for derived quantities
+  void setDerivedConfig(const DerivedConfig& config) { _derivedConfig = config; }
+
+  /// Frames that failed compensation since configure()
+  uint32_t errors() const { return _errors; }
+
+private:
+  PreparedCalibration _prep;
+  Channels _channels = Channels::TPH;
+  SampleFilter _filter;
+  DerivedConfig _derivedConfig;
+  uint32_t _errors = 0;
+};
+
+} // namespace BME280
@@ -0,0 +1,171 @@
+/// @file Group.h
+/// @brief Multi-sensor scheduler with staggered forced-mode triggers
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/BME280.h"
+
+namespace BME280 {
+
+/// Sample callback for Group
+/// @param index Device index within the group
+/// @param sample Compensated sample
+/// @param nowMs tick() time of the readout
+/// @param user User context pointer passed to Group::setCallback()
+using GroupSampleFn = void (*)(size_t index, const CompensatedSample& sample,
+                               uint32_t nowMs, void* user);
+
+/// Owns N driver instances and interleaves their conversions
+///
+/// start() spreads the first triggers over one measurement time, so each device's
+/// readout falls into the others' conversion windows. After every readout the
+/// device is re-triggered immediately, which keeps the stagger. tick() services due
+/// devices earliest-deadline first and leaves every other device alone until its
+/// tracked deadline; a device still converting at its deadline is retried 1 ms
+/// later. Call it at least once per millisecond, or sleep until nextDueMs().
+/// @tparam N Number of devices
+template <size_t N>
+class Group {
+  static_assert(N > 0, "Group needs at least one device");
+
+public:
+  /// Access device i (begin() it before start())
+  BME280& device(size_t i) { return _devices[i]; }
+  const BME280& device(size_t i) const { return _devices[i]; }
+
+  /// Number of devices
+  static constexpr size_t size() { return N; }
+
+  /// Set the sample callback
+  void setCallback(GroupSampleFn fn, void* user) {
+    _callback = fn;
+    _user = user;
+  }
+
+  /// Schedule staggered first triggers for all initialized devices
+  /// @param nowMs Current time
+  /// @return NOT_INITIALIZED if no device has been begun
+  Status start(uint32_t nowMs) {
+    uint32_t periodMs = 0;
+    size_t active = 0;
+    for (size_t i = 0; i < N; ++i) {
+      if (_devices[i].state() == DriverState::UNINIT) {
+        continue;
+      }
+      const uint32_t estimate = _devices[i].estimateMeasurementTimeMs();
+      if (estimate > periodMs) {
+        periodMs = estimate;
+      }
+      active++;
+    }
+    if (active == 0) {
+      return Status::Error(Err::NOT_INITIALIZED, "No device initialized");
+    }
+
+    size_t slot = 0;
+    for (size_t i = 0; i < N; ++i) {
+      _armed[i] = false;
+      _dueMs[i] = nowMs;
+      if (_devices[i].state() == DriverState::UNINIT) {
+        continue;
+      }
+      _dueMs[i] = nowMs + static_cast<uint32_t>((periodMs * slot) / active);
+      slot++;
+    }
+    _running = true;
+    return Status::Ok();
+  }
+
+  /// Stop triggering new measurements
+  void stop() { _running = false; }
+
+  /// Service due devices (earliest deadline first)
+  void tick(uint32_t nowMs) {
+    if (!_running) {
+      return;
+    }
+
+    bool serviced[N] = {};
+    for (;;) {
+      size_t next = N;
+      int32_t bestLag = 0;
+      for (size_t i = 0; i < N; ++i) {
+        if (serviced[i] || _devices[i].state() == DriverState::UNINIT) {
+          continue;
+        }
+        const int32_t lag = static_cast<int32_t>(nowMs - _dueMs[i]);
+        if (lag >= 0 && (next == N || lag > bestLag)) {
+          next = i;
+          bestLag = lag;
+        }
+      }
+      if (next == N) {
+        return;
+      }
+      serviced[next] = true;
+      _service(next, nowMs);
+    }
+  }
+
+  /// Earliest time any device needs tick()
+  uint32_t nextDueMs() const {
+    bool found = false;
+    uint32_t best = 0;
+    for (size_t i = 0; i < N; ++i) {
+      if (_devices[i].state() == DriverState::UNINIT) {
+        continue;
+      }
+      const uint32_t due = _dueMs[i];
+      if (!found || static_cast<int32_t>(due - best) < 0) {
+        best = due;
+        found = true;
+      }
+    }
+    return best;
+  }
+
+  /// Samples delivered to the callback since start()
+  uint32_t samplesDelivered() const { return _delivered; }
+
+private:
+  void _service(size_t i, uint32_t nowMs) {
+    BME280& dev = _devices[i];
+    if (_armed[i]) {
+      dev.tick(nowMs);
+      if (!dev.measurementReady()) {
+        // Still converting, bus error or offline: leave the device alone for 1 ms
+        _armed[i] = dev.measurementPending();
+        _dueMs[i] = nowMs + 1;
+        return;
+      }
+      _armed[i] = false;
+      CompensatedSample sample;
+      if (dev.getMeasurement(sample).ok()) {
+        _delivered++;
+        if (_callback != nullptr) {
+          _callback(i, sample, nowMs, _user);
+        }
+      }
+    }
+
+    // Re-arm right after the readout to keep the stagger
+    const Status st = dev.requestMeasurement();
+    if (st.ok() || st.code == Err::IN_PROGRESS) {
+      _armed[i] = true;
+      _dueMs[i] = dev.nextSampleDueMs();
+    } else {
+      _dueMs[i] = nowMs + 1;
+    }
+  }
+
+  BME280 _devices[N];
+  bool _armed[N] = {};
+  uint32_t _dueMs[N] = {};  // Next readout (armed) or trigger attempt
+  GroupSampleFn _callback = nullptr;
+  void* _user = nullptr;
+  uint32_t _delivered = 0;
+  bool _running = false;
+};
+
+} // namespace BME280
@@ -0,0 +1,70 @@
+/// @file Instrumentation.h
+/// @brief Bus transaction statistics (BME280_ENABLE_INSTRUMENTATION)
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/Features.h"
+#include "BME280/Status.h"
+
+#if BME280_TRACE_DEPTH < 1
+#error "BME280_TRACE_DEPTH must be at least 1"
+#endif
+
+namespace BME280 {
+
+/// Transaction kind, classified from the register address and length
+enum class BusOp : uint8_t {
+  STATUS_POLL = 0,       ///< 1-byte status read
+  DATA_READ = 1,         ///< Data block read (0xF7..0xFE or part of it)
+  FUSED_READ = 2,        ///< Status + data burst (0xF3..0xFE)
+  CALIBRATION_READ = 3,  ///< Calibration block read
+  REGISTER_READ = 4,     ///< Any other read (chip ID, control registers)
+  CONFIG_WRITE = 5,      ///< ctrl_hum/ctrl_meas/config write without a trigger
+  TRIGGER = 6,           ///< ctrl_meas write that starts a FORCED conversion
+  RESET = 7              ///< Soft reset write
+};
+
+/// Number of BusOp values
+static constexpr size_t BUS_OP_COUNT = 8;
+
+/// Latency histogram buckets: < 50, 100, 200, 500, 1000, 2000, 5000 us and above
+static constexpr size_t LATENCY_BUCKET_COUNT = 8;
+static constexpr uint32_t LATENCY_BUCKET_LIMIT_US[LATENCY_BUCKET_COUNT - 1] = {
+    50, 100, 200, 500, 1000, 2000, 5000};
+
+/// Counters for one transaction kind
+struct BusOpStats {
+  uint32_t count = 0;     ///< Transactions issued
+  uint32_t failures = 0;  ///< Transactions that returned an error
+  uint32_t bytes = 0;     ///< Bytes transferred (register address + data)
+  uint32_t totalUs = 0;   ///< Accumulated latency
+  uint32_t maxUs = 0;     ///< Largest single latency
+};
+
+/// Bus statistics since begin() or BME280::resetBusStats()
+struct BusStats {
+  BusOpStats ops[BUS_OP_COUNT];                    ///< Indexed by BusOp
+  uint32_t latencyHistogram[LATENCY_BUCKET_COUNT] = {};  ///< All kinds
+};
+
+/// One traced transaction
+struct BusTraceEntry {
+  uint32_t startUs = 0;     ///< Clock at submission
+  uint32_t latencyUs = 0;   ///< Duration (async: until the completion was observed)
+  uint8_t reg = 0;          ///< First register address
+  uint8_t len = 0;          ///< Bytes transferred (saturates at 255)
+  BusOp op = BusOp::REGISTER_READ;
+  Err code = Err::OK;       ///< Result
+};
+
+/// Histogram bucket for a latency
+inline size_t latencyBucket(uint32_t latencyUs) {
+  size_t bucket = 0;
+  while (bucket < LATENCY_BUCKET_COUNT - 1 && latencyUs >= LATENCY_BUCKET_LIMIT_US[bucket]) {
+    bucket++;
+  }
+  return bucket;
+}
+
+} // namespace BME280
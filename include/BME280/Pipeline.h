@@ -0,0 +1,100 @@
+/// @file Pipeline.h
+/// @brief Optional dual-core FreeRTOS acquisition/processing pipeline (ESP32)
+#pragma once
+
+#if defined(ESP_PLATFORM)
+
+#include <atomic>
+#include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "BME280/BME280.h"
+#include "BME280/FrameProcessor.h"
+#include "BME280/SpscRing.h"
+
+namespace BME280 {
+
+/// Processed-sample callback, invoked on the processing core
+using PipelineSampleFn = void (*)(const TimestampedSample& sample, void* user);
+
+/// Derived-quantity callback, invoked on the processing core after onSample
+using PipelineDerivedFn = void (*)(const TimestampedSample& sample,
+                                   const DerivedSample& derived, void* user);
+
+/// Pipeline task settings
+struct PipelineConfig {
+  PipelineSampleFn onSample = nullptr;    ///< Called for every filtered sample
+  PipelineDerivedFn onDerived = nullptr;  ///< Derived quantities per sample (nullptr: not computed)
+  DerivedConfig derived;                  ///< Reference values for onDerived
+  void* user = nullptr;                   ///< User context for onSample and onDerived
+  int acquisitionCore = 0;                ///< Core for the bus task (tick())
+  int processingCore = 1;                 ///< Core for compensation, filter and callbacks
+  uint32_t acquisitionStackBytes = 4096;  ///< Bus task stack size
+  uint32_t processingStackBytes = 4096;   ///< Processing task stack size
+  UBaseType_t acquisitionPriority = 5;    ///< Bus task priority
+  UBaseType_t processingPriority = 4;     ///< Processing task priority
+  uint32_t idleDelayMs = 1;               ///< Minimum bus task sleep between ticks
+};
+
+/// Two pinned tasks connected by a raw-frame SPSC ring
+///
+/// The acquisition task owns the BME280 instance while the pipeline runs: it
+/// requests measurements, calls tick() with millis() and sleeps until
+/// nextSampleDueMs(). tick() pushes raw frames into the ring. The processing task
+/// runs a FrameProcessor: it pops frames, compensates them in batches with a
+/// calibration snapshot taken in start(), applies the device's SampleFilter settings
+/// (also a start() snapshot) and invokes PipelineConfig::onSample, then onDerived.
+/// The deadband and window statistics of tick() do not run on this path.
+///
+/// Do not call any BME280 member function from other tasks between start() and
+/// stop(). Config::clockUs, if set, must be consistent with millis().
+class Pipeline {
+public:
+  Pipeline() = default;
+  Pipeline(const Pipeline&) = delete;
+  Pipeline& operator=(const Pipeline&) = delete;
+  ~Pipeline() { stop(); }
+
+  /// Attach the ring to the device and start both tasks
+  /// @param device Initialized driver (begin() succeeded)
+  /// @param ring Raw-frame ring (must outlive the pipeline)
+  /// @param config Task settings
+  Status start(BME280& device, SpscRing<RawFrame>& ring, const PipelineConfig& config);
+
+  /// Stop both tasks, wait for them to exit and detach the ring
+  /// Blocks on a task notification until both tasks have exited. Call it from a
+  /// task other than the pipeline's own (not from onSample or onDerived).
+  void stop();
+
+  /// True between start() and stop()
+  bool running() const { return _running.load(std::memory_order_acquire); }
+
+  /// Samples delivered to onSample
+  uint32_t samplesProcessed() const { return _processed.load(std::memory_order_relaxed); }
+
+  /// Frames that failed compensation
+  uint32_t compensationErrors() const { return _errors.load(std::memory_order_relaxed); }
+
+private:
+  static void _acquisitionEntry(void* arg);
+  static void _processingEntry(void* arg);
+  void _runAcquisition();
+  void _runProcessing();
+  void _exitTask();
+
+  BME280* _device = nullptr;
+  SpscRing<RawFrame>* _ring = nullptr;
+  PipelineConfig _config;
+  FrameProcessor _processor;  // Snapshot at start(); processing task only
+  TaskHandle_t _acquisitionTask = nullptr;
+  TaskHandle_t _processingTask = nullptr;
+  TaskHandle_t _stopper = nullptr;  // Task blocked in stop()
+  std::atomic<bool> _running{false};
+  std::atomic<uint8_t> _activeTasks{0};
+  std::atomic<uint32_t> _processed{0};
+  std::atomic<uint32_t> _errors{0};
+};
+
+} // namespace BME280
+
+#endif // ESP_PLATFORM
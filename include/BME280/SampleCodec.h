@@ -0,0 +1,120 @@
+/// @file SampleCodec.h
+/// @brief Delta + zigzag varint stream format for timestamped compensated samples
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/BME280.h"
+
+namespace BME280 {
+
+/// Stream format version written by SampleEncoder
+static constexpr uint8_t SAMPLE_CODEC_VERSION = 1;
+
+/// Size of the stream header
+static constexpr size_t SAMPLE_CODEC_HEADER_SIZE = 7;
+
+/// Largest encoded record (timestamp + T + P + H, 5 bytes each)
+static constexpr size_t SAMPLE_CODEC_MAX_RECORD = 20;
+
+/// Value units of a stream
+enum class SampleUnits : uint8_t {
+  FIXED_POINT = 0  ///< CompensatedSample units (degC*100, Pa, %RH*1024), timestamps in ms
+};
+
+/// Stream header
+/// Layout: [0..1] magic "BS", [2] version, [3] Channels bits, [4] SampleUnits,
+/// [5..6] calibration ID (little-endian)
+struct SampleStreamHeader {
+  uint8_t version = SAMPLE_CODEC_VERSION;
+  Channels channels = Channels::TPH;            ///< Channels in each record (encoder drops compiled-out ones)
+  SampleUnits units = SampleUnits::FIXED_POINT;
+  uint16_t calibrationId = 0;                   ///< Identifies the sensor (see calibrationId())
+};
+
+/// Calibration ID for a stream header: the CRC of an exportCalibration() blob
+inline uint16_t calibrationId(const CalibrationBlob& blob) {
+  return static_cast<uint16_t>(blob.data[CALIBRATION_BLOB_SIZE - 2] |
+                               (blob.data[CALIBRATION_BLOB_SIZE - 1] << 8));
+}
+
+/// Streaming encoder over a caller-provided buffer
+///
+/// Each record holds the zigzag varint of the change in timestamp step (delta of
+/// delta; the first record carries the absolute timestamp), then the zigzag varint
+/// deltas of T, P and H (channels in the header only). A steady periodic TPH
+/// stream takes 4 bytes per sample from the third record on (2 bytes for
+/// temperature only). Records are written whole or not at all.
+/// Decoding needs every byte from the header on. Call begin() again to start an
+/// independently decodable stream (e.g. per radio packet or flash page).
+class SampleEncoder {
+public:
+  /// @param buffer Output storage
+  /// @param capacity Size of buffer
+  SampleEncoder(uint8_t* buffer, size_t capacity) : _buffer(buffer), _capacity(capacity) {}
+
+  /// Write a header and restart the delta state
+  /// @return INVALID_PARAM without a buffer, BUSY if the header does not fit
+  Status begin(const SampleStreamHeader& header);
+
+  /// Append one sample
+  /// @return NOT_INITIALIZED before begin(), BUSY if the record does not fit (flush
+  ///         data(), call clear(), retry)
+  Status encode(const CompensatedSample& sample, uint32_t timestampMs);
+
+  /// Encoded bytes
+  const uint8_t* data() const { return _buffer; }
+  size_t size() const { return _size; }
+
+  /// Drop the buffered bytes after they were written out; the stream continues
+  void clear() { _size = 0; }
+
+private:
+  uint8_t* _buffer;
+  size_t _capacity;
+  size_t _size = 0;
+  bool _started = false;
+  bool _hasRecord = false;
+  Channels _channels = Channels::TPH;
+  uint32_t _lastMs = 0;
+  uint32_t _lastStepMs = 0;
+  int32_t _last[3] = {};
+};
+
+/// Decoder for one SampleEncoder stream
+class SampleDecoder {
+public:
+  /// @param data Stream bytes, starting with the header
+  /// @param len Number of bytes
+  SampleDecoder(const uint8_t* data, size_t len) : _data(data), _len(len) {}
+
+  /// Parse the header
+  /// @return INVALID_PARAM on a bad magic, unknown version/units or short buffer
+  Status readHeader(SampleStreamHeader& out);
+
+  /// Decode the next record
+  /// @return false at the end of the data, on a truncated record or before readHeader()
+  bool next(CompensatedSample& out, uint32_t& timestampMs);
+
+  /// True if the data ended inside a record
+  bool truncated() const { return _truncated; }
+
+  /// Bytes consumed so far
+  size_t position() const { return _pos; }
+
+private:
+  bool _readVarint(uint32_t& out);
+
+  const uint8_t* _data;
+  size_t _len;
+  size_t _pos = 0;
+  bool _started = false;
+  bool _truncated = false;
+  bool _hasRecord = false;
+  Channels _channels = Channels::TPH;
+  uint32_t _lastMs = 0;
+  uint32_t _lastStepMs = 0;
+  int32_t _last[3] = {};
+};
+
+} // namespace BME280
@@ -0,0 +1,75 @@
+/// @file SampleFilter.h
+/// @brief Integer median + IIR filter stage for compensated samples
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/Compensation.h"
+
+namespace BME280 {
+
+/// Median window length
+enum class MedianTaps : uint8_t {
+  OFF = 1,     ///< No median stage
+  TAPS_3 = 3,  ///< Median of the last 3 samples (rejects single-sample spikes)
+  TAPS_5 = 5   ///< Median of the last 5 samples (rejects two-sample spikes)
+};
+
+/// Largest IIR shift (alpha = 1/128)
+static constexpr uint8_t SAMPLE_IIR_MAX_SHIFT = 7;
+
+/// Filter settings for one channel
+struct ChannelFilterConfig {
+  MedianTaps median = MedianTaps::OFF; ///< Spike rejection, applied first
+  uint8_t iirShift = 0;                ///< IIR y += (x - y) / 2^shift; 0 disables, at most 7
+};
+
+/// Per-channel settings of the software filter stage (default: pass-through)
+/// Unlike the hardware IIR (setFilter()), this covers humidity, changes without a
+/// register write, and its shift k matches hardware coefficient 2^k.
+struct SampleFilterConfig {
+  ChannelFilterConfig temperature; ///< tempC_x100
+  ChannelFilterConfig pressure;    ///< pressurePa
+  ChannelFilterConfig humidity;    ///< humidityPct_x1024
+
+  /// True if any stage is enabled
+  bool active() const;
+};
+
+/// Median + first-order IIR over CompensatedSample fields, integer only
+/// The IIR state keeps 8 fractional bits, so small steps are not lost to truncation.
+/// The first sample after reset() seeds the IIR (no start-up ramp); the median works
+/// on the samples seen so far until its window is full.
+class SampleFilter {
+public:
+  /// Replace the settings and reset the state
+  void configure(const SampleFilterConfig& config);
+
+  /// Current settings
+  const SampleFilterConfig& config() const { return _config; }
+
+  /// Drop history; the next sample passes through unchanged
+  void reset();
+
+  /// Filter one sample in place
+  void apply(CompensatedSample& sample);
+
+private:
+  static constexpr size_t CHANNELS = 3;
+  static constexpr size_t MAX_TAPS = 5;
+
+  struct ChannelState {
+    int32_t history[MAX_TAPS] = {};
+    uint8_t count = 0;    // Valid history entries
+    uint8_t next = 0;     // Next history slot
+    bool seeded = false;  // IIR state valid
+    int64_t iirQ8 = 0;    // IIR output with 8 fractional bits
+  };
+
+  int32_t _applyChannel(const ChannelFilterConfig& config, ChannelState& state, int32_t value);
+
+  SampleFilterConfig _config;
+  ChannelState _state[CHANNELS];
+};
+
+} // namespace BME280
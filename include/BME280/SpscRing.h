@@ -0,0 +1,131 @@
+/// @file SpscRing.h
+/// @brief Lock-free single-producer/single-consumer ring buffer
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "BME280/Compensation.h"
+
+namespace BME280 {
+
+/// What push() does when the ring is full
+enum class RingPolicy : uint8_t {
+  DROP_NEWEST,     ///< Keep queued items, discard the new one
+  OVERWRITE_OLDEST ///< Discard the oldest queued item to make room
+};
+
+/// Compensated sample with the tick() time it was read
+struct TimestampedSample {
+  uint32_t timestampMs = 0;   ///< tick() time of the read
+  CompensatedSample sample;   ///< Compensated values
+};
+
+/// SPSC ring over caller-provided storage
+/// One producer calls push(), one consumer calls pop(); no locks. Both sides may
+/// run on different cores or in different tasks. Use StaticSpscRing to allocate.
+template <typename T>
+class SpscRing {
+public:
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /// Producer: append an item
+  /// @return false if the item was dropped (DROP_NEWEST on a full ring)
+  bool push(const T& item) {
+    const uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    if (head - tail >= _capacity) {
+      if (_policy == RingPolicy::DROP_NEWEST) {
+        _overruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      // Discard the oldest item. If the consumer popped it first, a slot is free anyway.
+      if (_tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+        _overruns.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    _slots[head & _mask] = item;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer: remove the oldest item
+  /// @return false if the ring is empty
+  bool pop(T& out) {
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+    for (;;) {
+      const uint32_t head = _head.load(std::memory_order_acquire);
+      if (tail == head) {
+        return false;
+      }
+      out = _slots[tail & _mask];
+      // Fails only if the producer overwrote this slot meanwhile; retry with the new tail
+      if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        return true;
+      }
+    }
+  }
+
+  /// Number of queued items (snapshot)
+  size_t size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  /// True if no items are queued (snapshot)
+  bool empty() const { return size() == 0; }
+
+  /// Maximum number of queued items
+  size_t capacity() const { return _capacity; }
+
+  /// Items lost to a full ring (dropped or overwritten)
+  uint32_t overruns() const { return _overruns.load(std::memory_order_relaxed); }
+
+  /// Full-ring behavior
+  RingPolicy policy() const { return _policy; }
+
+protected:
+  /// @param slots Storage for capacity items
+  /// @param capacity Number of slots (power of two)
+  /// @param policy Full-ring behavior
+  SpscRing(T* slots, uint32_t capacity, RingPolicy policy)
+      : _slots(slots), _capacity(capacity), _mask(capacity - 1), _policy(policy) {}
+
+private:
+  T* _slots;
+  uint32_t _capacity;
+  uint32_t _mask;
+  RingPolicy _policy;
+  std::atomic<uint32_t> _head{0};     // Written by the producer
+  std::atomic<uint32_t> _tail{0};     // Written by the consumer (and producer on overwrite)
+  std::atomic<uint32_t> _overruns{0};
+};
+
+/// SPSC ring with embedded storage
+/// @tparam T Item type (trivially copyable)
+/// @tparam N Capacity, a power of two
+template <typename T, size_t N>
+class StaticSpscRing : public SpscRing<T> {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "Ring capacity must be a power of two");
+  static_assert(N <= (static_cast<size_t>(1) << 31), "Ring capacity too large");
+
+public:
+  explicit StaticSpscRing(RingPolicy policy = RingPolicy::DROP_NEWEST)
+      : SpscRing<T>(_storage, static_cast<uint32_t>(N), policy) {}
+
+private:
+  T _storage[N] = {};
+};
+
+/// Ring of compensated samples filled by BME280::tick()
+template <size_t N>
+using SampleRing = StaticSpscRing<TimestampedSample, N>;
+
+/// Ring of raw frames filled by BME280::tick() (see BME280::attachFrameRing())
+template <size_t N>
+using FrameRing = StaticSpscRing<RawFrame, N>;
+
+} // namespace BME280
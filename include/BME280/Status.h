@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstdint>
+#include "BME280/Features.h"
 
 namespace BME280 {
 
@@ -23,6 +24,8 @@ enum class Err : uint8_t {
   IN_PROGRESS                ///< Operation scheduled; call tick() to complete
 };
 
+#if BME280_ENABLE_STATUS_MESSAGES
+
 /// Status structure returned by all fallible operations
 struct Status {
   Err code = Err::OK;
@@ -35,6 +38,9 @@ struct Status {
   /// @return true if operation succeeded
   constexpr bool ok() const { return code == Err::OK; }
 
+  /// Static string describing the error ("" when messages are compiled out)
+  constexpr const char* message() const { return msg; }
+
   /// Create a success status
   static constexpr Status Ok() { return Status{Err::OK, 0, "OK"}; }
   
@@ -44,4 +50,39 @@ struct Status {
   }
 };
 
+#else
+
+/// Compact status (BME280_ENABLE_STATUS_MESSAGES=0): 4 bytes, no message
+/// Error() still takes the message so call sites are unchanged; nothing keeps a
+/// reference to it, so the literals are not emitted.
+/// Use message() instead of msg in code that builds in both profiles.
+struct Status {
+  Err code = Err::OK;
+  int16_t detail = 0;        ///< Implementation-specific detail, saturated to int16_t
+
+  constexpr Status() = default;
+  constexpr Status(Err c, int32_t d, const char* = "") : code(c), detail(clampDetail(d)) {}
+
+  /// @return true if operation succeeded
+  constexpr bool ok() const { return code == Err::OK; }
+
+  /// Always "" (messages compiled out)
+  constexpr const char* message() const { return ""; }
+
+  /// Create a success status
+  static constexpr Status Ok() { return Status{Err::OK, 0}; }
+
+  /// Create an error status
+  static constexpr Status Error(Err err, const char* /*message*/, int32_t detailCode = 0) {
+    return Status{err, detailCode};
+  }
+
+private:
+  static constexpr int16_t clampDetail(int32_t d) {
+    return static_cast<int16_t>(d > INT16_MAX ? INT16_MAX : (d < INT16_MIN ? INT16_MIN : d));
+  }
+};
+
+#endif
+
 } // namespace BME280
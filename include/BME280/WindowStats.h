@@ -0,0 +1,166 @@
+/// @file WindowStats.h
+/// @brief Incremental windowed statistics over compensated samples
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/Compensation.h"
+
+namespace BME280 {
+
+/// Largest number of samples in one window (keeps the 64-bit sums exact)
+static constexpr uint32_t WINDOW_MAX_SAMPLES = 65535;
+
+/// Statistics of one channel, in the units of the CompensatedSample field
+struct ChannelSummary {
+  int32_t min = 0;
+  int32_t max = 0;
+  int32_t mean = 0;        ///< Rounded to the nearest unit (ties up)
+  uint64_t variance = 0;   ///< Population variance, in units^2 (truncated)
+  uint32_t stddev = 0;     ///< floor(sqrt(variance))
+};
+
+/// Statistics of one window
+struct WindowSummary {
+  uint32_t count = 0;         ///< Samples in the window
+  uint32_t firstMs = 0;       ///< Time of the first sample
+  uint32_t lastMs = 0;        ///< Time of the last sample
+  ChannelSummary temperature; ///< tempC_x100
+  ChannelSummary pressure;    ///< pressurePa
+  ChannelSummary humidity;    ///< humidityPct_x1024
+};
+
+/// Completed-window callback (tumbling windows)
+/// @param summary Statistics of the window that just closed
+/// @param user User context pointer passed to setCallback()
+using WindowFn = void (*)(const WindowSummary& summary, void* user);
+
+/// Integer window accumulator, O(1) per sample
+///
+/// Sums are kept relative to a per-channel offset (the first sample of the window)
+/// in 64-bit integers, so adding and removing samples is exact and the variance
+/// does not drift. Use TumblingWindowStats or SlidingWindowStats<N>; attach either
+/// with BME280::attachWindowStats() to feed it from tick().
+/// Not thread-safe: call add(), summary() and reset() from one task (the one
+/// calling tick() when attached), or synchronize externally.
+class WindowStats {
+public:
+  WindowStats(const WindowStats&) = delete;
+  WindowStats& operator=(const WindowStats&) = delete;
+
+  /// Add one sample
+  /// Tumbling: closes the window first if the sample falls beyond its end.
+  /// Sliding: evicts the oldest sample once the window is full.
+  void add(const CompensatedSample& sample, uint32_t nowMs);
+
+  /// Statistics of the current (open or sliding) window
+  /// @return false if the window is empty
+  bool summary(WindowSummary& out) const;
+
+  /// Statistics of the most recently closed tumbling window
+  /// @return false if no window has closed yet
+  bool lastWindow(WindowSummary& out) const;
+
+  /// Tumbling windows closed since construction or reset()
+  uint32_t windowsClosed() const { return _windowsClosed; }
+
+  /// Samples in the current window
+  uint32_t count() const { return _count; }
+
+  /// Set the callback invoked when a tumbling window closes (from add())
+  void setCallback(WindowFn fn, void* user) {
+    _callback = fn;
+    _user = user;
+  }
+
+  /// Drop all samples and counters
+  void reset();
+
+protected:
+  struct Slot {
+    int32_t value[3];
+    uint32_t timeMs;
+  };
+
+  /// Tumbling window
+  /// @param periodMs Window length in ms (0: by count only)
+  /// @param maxSamples Close after this many samples (clamped to WINDOW_MAX_SAMPLES)
+  WindowStats(uint32_t periodMs, uint32_t maxSamples);
+
+  /// Sliding window over the last capacity samples
+  /// @param slots Sample storage (capacity entries)
+  /// @param deques Monotonic deque storage (6 * capacity entries)
+  WindowStats(Slot* slots, uint32_t* deques, uint32_t capacity);
+
+private:
+  static constexpr size_t CHANNELS = 3;
+
+  struct Accumulator {
+    int32_t offset = 0;
+    int64_t sum = 0;      // Sum of (x - offset)
+    uint64_t sumSq = 0;   // Sum of (x - offset)^2
+    int32_t min = 0;      // Tumbling only; sliding uses the deques
+    int32_t max = 0;
+  };
+
+  void _closeWindow();
+  void _accumulate(const int32_t (&values)[CHANNELS]);
+  void _evictOldest();
+  void _summarize(WindowSummary& out) const;
+
+  uint32_t _oldestSlot() const;
+
+  // Monotonic deques of slot indices, oldest first: 0..2 min, 3..5 max per channel
+  uint32_t* _deque(size_t d) const { return _deques + d * _capacity; }
+  void _dequePush(size_t d, uint32_t index, int32_t value, bool isMax);
+  int32_t _dequeFront(size_t d) const;
+
+  // Configuration
+  Slot* _slots = nullptr;      // Sliding only
+  uint32_t* _deques = nullptr; // Sliding only
+  uint32_t _capacity = 0;      // Sliding window size, or tumbling maxSamples
+  uint32_t _periodMs = 0;      // Tumbling only
+  bool _sliding = false;
+
+  // Window state
+  Accumulator _acc[CHANNELS];
+  uint32_t _count = 0;
+  uint32_t _firstMs = 0;
+  uint32_t _lastMs = 0;
+  uint32_t _nextSlot = 0;      // Slot for the next sample (sliding)
+  uint32_t _dequeHead[2 * CHANNELS] = {};
+  uint32_t _dequeSize[2 * CHANNELS] = {};
+
+  // Completed windows
+  WindowSummary _last;
+  uint32_t _windowsClosed = 0;
+  WindowFn _callback = nullptr;
+  void* _user = nullptr;
+};
+
+/// Tumbling window closing every periodMs or every maxSamples samples
+class TumblingWindowStats : public WindowStats {
+public:
+  /// @param periodMs Window length in ms (e.g. 60000 for 1-minute aggregates; 0: by count)
+  /// @param maxSamples Close after this many samples (at most WINDOW_MAX_SAMPLES)
+  explicit TumblingWindowStats(uint32_t periodMs, uint32_t maxSamples = WINDOW_MAX_SAMPLES)
+      : WindowStats(periodMs, maxSamples) {}
+};
+
+/// Sliding window over the last N samples with embedded storage
+/// Min/max use monotonic deques (amortized O(1)); memory is 40 * N bytes.
+/// @tparam N Window size in samples
+template <size_t N>
+class SlidingWindowStats : public WindowStats {
+  static_assert(N > 0 && N <= WINDOW_MAX_SAMPLES, "Sliding window size out of range");
+
+public:
+  SlidingWindowStats()
+      : WindowStats(_slotStorage, _dequeStorage, static_cast<uint32_t>(N)) {}
+
+private:
+  Slot _slotStorage[N] = {};
+  uint32_t _dequeStorage[6 * N] = {};
+};
+
+} // namespace BME280
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+Compare two benchmark outputs from the bench_native environment.
+
+Usage:
+    pio run -e bench_native -t exec > base.txt     (on the reference commit)
+    pio run -e bench_native -t exec > new.txt      (on the candidate)
+    python3 scripts/bench_compare.py base.txt new.txt [--threshold 5]
+
+Exits 1 if any metric moved in its worse direction by more than the threshold.
+Timing metrics (*.ns_per_sample) get --timing-threshold, as host timing is noisy.
+"""
+
+import argparse
+import sys
+
+
+def load(path):
+    """Parse 'BENCH <metric> <value> <lower|higher>' lines."""
+    results = {}
+    with open(path, encoding="utf-8") as handle:
+        for line in handle:
+            parts = line.split()
+            if len(parts) == 4 and parts[0] == "BENCH":
+                results[parts[1]] = (float(parts[2]), parts[3])
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("base")
+    parser.add_argument("new")
+    parser.add_argument("--threshold", type=float, default=1.0,
+                        help="allowed regression in percent for simulated metrics")
+    parser.add_argument("--timing-threshold", type=float, default=15.0,
+                        help="allowed regression in percent for ns_per_sample metrics")
+    args = parser.parse_args()
+
+    base = load(args.base)
+    new = load(args.new)
+    regressions = 0
+
+    print(f"{'metric':48} {'base':>12} {'new':>12} {'change':>9}")
+    for metric in sorted(set(base) | set(new)):
+        if metric not in base or metric not in new:
+            state = "added" if metric in new else "removed"
+            print(f"{metric:48} {state:>35}")
+            continue
+        old_value, better = base[metric]
+        new_value, _ = new[metric]
+        if old_value == 0:
+            change = 0.0 if new_value == 0 else float("inf")
+        else:
+            change = (new_value - old_value) / old_value * 100.0
+        worse = change > 0 if better == "lower" else change < 0
+        limit = args.timing_threshold if metric.endswith("ns_per_sample") else args.threshold
+        flag = ""
+        if worse and abs(change) > limit:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{metric:48} {old_value:12.3f} {new_value:12.3f} {change:8.1f}%{flag}")
+
+    if regressions:
+        print(f"{regressions} regression(s)")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
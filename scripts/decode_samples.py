@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Decode a sample stream written by BME280::SampleEncoder (see SampleCodec.h).
+
+Usage:
+    python3 scripts/decode_samples.py stream.bin [--raw] > samples.csv
+
+Prints one CSV row per sample: timestamp_ms, temperature, pressure, humidity.
+Values are in degC, hPa and %RH, or the fixed-point CompensatedSample units with
+--raw. Channels absent from the stream are left empty. Exits 1 on a bad header
+or a truncated final record (rows decoded before it are still printed).
+"""
+
+import argparse
+import sys
+
+MAGIC = b"BS"
+VERSION = 1
+HEADER_SIZE = 7
+UNITS_FIXED_POINT = 0
+CHANNEL_PRESSURE = 0x02
+CHANNEL_HUMIDITY = 0x04
+VARINT_MAX = 5
+
+
+class StreamError(Exception):
+    pass
+
+
+def to_int32(value):
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def read_varint(data, pos):
+    """Return (value, new position); raise StreamError if truncated or over-long."""
+    value = 0
+    for i in range(VARINT_MAX):
+        if pos >= len(data):
+            raise StreamError("truncated record at byte %d" % pos)
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << (7 * i)
+        if not byte & 0x80:
+            return value, pos
+    raise StreamError("over-long varint at byte %d" % pos)
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def read_header(data):
+    if len(data) < HEADER_SIZE or data[0:2] != MAGIC:
+        raise StreamError("not a sample stream")
+    if data[2] != VERSION or data[4] != UNITS_FIXED_POINT:
+        raise StreamError("unsupported stream format (version %d, units %d)" % (data[2], data[4]))
+    return {
+        "channels": data[3],
+        "calibration_id": data[5] | (data[6] << 8),
+    }
+
+
+def decode(data):
+    """Yield (timestamp_ms, [temp, pressure, humidity]) in fixed-point units."""
+    header = read_header(data)
+    present = [True,
+               bool(header["channels"] & CHANNEL_PRESSURE),
+               bool(header["channels"] & CHANNEL_HUMIDITY)]
+    pos = HEADER_SIZE
+    last_ms = 0
+    last_step = 0
+    last = [0, 0, 0]
+    first = True
+    while pos < len(data):
+        raw, pos = read_varint(data, pos)
+        step = (last_step + unzigzag(raw)) & 0xFFFFFFFF
+        values = [None, None, None]
+        for c in range(3):
+            if present[c]:
+                raw, pos = read_varint(data, pos)
+                last[c] = to_int32(last[c] + unzigzag(raw))
+                values[c] = last[c]
+        # The first record carries the absolute time, which is not a sampling step
+        last_step = 0 if first else step
+        last_ms = (last_ms + step) & 0xFFFFFFFF
+        first = False
+        yield last_ms, values
+
+
+def scaled(values):
+    scale = (100.0, 100.0, 1024.0)  # degC, hPa, %RH
+    out = []
+    for value, div in zip(values, scale):
+        out.append("" if value is None else "%.2f" % (value / div))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("stream")
+    parser.add_argument("--raw", action="store_true",
+                        help="print fixed-point CompensatedSample values")
+    args = parser.parse_args()
+
+    with open(args.stream, "rb") as handle:
+        data = handle.read()
+
+    try:
+        header = read_header(data)
+        print("# calibration_id 0x%04x channels 0x%02x" % (header["calibration_id"],
+                                                         header["channels"]))
+        print("timestamp_ms,temperature,pressure,humidity")
+        for timestamp, values in decode(data):
+            fields = ["" if v is None else str(v) for v in values] if args.raw else scaled(values)
+            print(",".join([str(timestamp)] + fields))
+    except StreamError as err:
+        print("error: %s" % err, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
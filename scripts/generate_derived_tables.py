@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+Generate the lookup tables used by src/Derived.cpp.
+Run from the project root and paste the output over the tables block.
+"""
+
+import math
+
+# International barometric formula (ICAO standard atmosphere)
+ALT_SCALE_M = 44330.77
+ALT_EXPONENT = 0.190263
+
+# Magnus coefficients over water (Sonntag 1990 / WMO)
+MAGNUS_A_HPA = 6.112
+MAGNUS_B = 17.62
+MAGNUS_C = 243.12
+
+# Altitude: p/p0 in Q20 from 0.25 to 1.25, 256 segments of 4096
+ALT_RATIO_MIN_Q20 = 262144
+ALT_RATIO_SHIFT = 12
+ALT_SEGMENTS = 256
+
+# Sea-level factor: altitude from -512 m, 256 segments of 4096 cm
+SLP_ALT_MIN_CM = -51200
+SLP_ALT_SHIFT = 12
+SLP_SEGMENTS = 256
+
+# Saturation vapor pressure: -60 to +88 degC, 1 degC steps
+ES_TEMP_MIN_C = -60
+ES_TEMP_STEP_C = 1
+ES_SEGMENTS = 148
+
+
+def altitude_m(ratio):
+    return ALT_SCALE_M * (1.0 - ratio ** ALT_EXPONENT)
+
+
+def sea_level_factor(alt_m):
+    return (1.0 - alt_m / ALT_SCALE_M) ** (-1.0 / ALT_EXPONENT)
+
+
+def saturation_pa(temp_c):
+    return 100.0 * MAGNUS_A_HPA * math.exp(MAGNUS_B * temp_c / (MAGNUS_C + temp_c))
+
+
+def emit(name, ctype, values, per_line=8):
+    print(f"static constexpr {ctype} {name}[{len(values)}] = {{")
+    for i in range(0, len(values), per_line):
+        chunk = ", ".join(str(v) for v in values[i:i + per_line])
+        print(f"  {chunk},")
+    print("};")
+    print()
+
+
+def main():
+    alt = []
+    for i in range(ALT_SEGMENTS + 1):
+        ratio = (ALT_RATIO_MIN_Q20 + (i << ALT_RATIO_SHIFT)) / float(1 << 20)
+        alt.append(round(altitude_m(ratio) * 100.0))
+    emit("ALTITUDE_CM", "int32_t", alt)
+
+    slp = []
+    for i in range(SLP_SEGMENTS + 1):
+        alt_m = (SLP_ALT_MIN_CM + (i << SLP_ALT_SHIFT)) / 100.0
+        slp.append(round(sea_level_factor(alt_m) * (1 << 24)))
+    emit("SEA_LEVEL_FACTOR_Q24", "uint32_t", slp)
+
+    es = []
+    for i in range(ES_SEGMENTS + 1):
+        es.append(round(saturation_pa(ES_TEMP_MIN_C + i * ES_TEMP_STEP_C) * 1000.0))
+    emit("SATURATION_MPA", "uint32_t", es)
+
+
+if __name__ == "__main__":
+    main()
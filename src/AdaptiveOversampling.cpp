@@ -0,0 +1,182 @@
+/// @file AdaptiveOversampling.cpp
+/// @brief Oversampling controller driven by the observed sample-to-sample noise
+
+#include "BME280/AdaptiveOversampling.h"
+
+namespace BME280 {
+namespace {
+
+static constexpr uint16_t MIN_BLOCK_SAMPLES = 4;
+
+static void sampleValues(const CompensatedSample& sample, int32_t (&out)[3]) {
+  out[0] = sample.tempC_x100;
+  out[1] = static_cast<int32_t>(sample.pressurePa);
+  out[2] = static_cast<int32_t>(sample.humidityPct_x1024);
+}
+
+/// Lowest setting the controller may select (never SKIP)
+static uint8_t lowerBound(const AdaptiveChannelConfig& config) {
+  return (config.min == Oversampling::SKIP) ? static_cast<uint8_t>(Oversampling::X1)
+                                            : static_cast<uint8_t>(config.min);
+}
+
+/// current moved into [min, max] for a controlled channel
+static Oversampling clampOversampling(const AdaptiveChannelConfig& config, Oversampling current) {
+  if (config.targetNoise == 0 || current == Oversampling::SKIP) {
+    return current;
+  }
+  const uint8_t level = static_cast<uint8_t>(current);
+  const uint8_t lo = lowerBound(config);
+  const uint8_t hi = static_cast<uint8_t>(config.max);
+  if (level < lo) {
+    return static_cast<Oversampling>(lo);
+  }
+  if (level > hi) {
+    return static_cast<Oversampling>(hi);
+  }
+  return current;
+}
+
+/// Next setting for one channel, or current if no step is needed
+static Oversampling stepOversampling(const AdaptiveChannelConfig& config, Oversampling current,
+                                     uint64_t noiseVariance) {
+  if (config.targetNoise == 0 || current == Oversampling::SKIP) {
+    return current;
+  }
+  const uint64_t target = static_cast<uint64_t>(config.targetNoise) * config.targetNoise;
+  const uint8_t level = static_cast<uint8_t>(current);
+  const uint8_t lo = lowerBound(config);
+  const uint8_t hi = static_cast<uint8_t>(config.max);
+
+  if (noiseVariance > target && level < hi) {
+    return static_cast<Oversampling>(level + 1);
+  }
+  // One setting lower doubles the variance; keep 20 % headroom (2 * v <= 0.8 * t)
+  if (10 * noiseVariance <= 4 * target && level > lo) {
+    return static_cast<Oversampling>(level - 1);
+  }
+  return current;
+}
+
+/// Read back the driver's settings (no bus access)
+static Status currentSettings(const BME280& device, ConfigBatch& out) {
+  Status st = device.getOversamplingT(out.osrsT);
+  if (!st.ok()) {
+    return st;
+  }
+  // The remaining getters only fail before begin(), which the first one caught
+  device.getOversamplingP(out.osrsP);
+  device.getOversamplingH(out.osrsH);
+  device.getFilter(out.filter);
+  device.getStandby(out.standby);
+  return device.getMode(out.mode);
+}
+
+} // namespace
+
+AdaptiveOversampling::AdaptiveOversampling(const AdaptiveOversamplingConfig& config) {
+  configure(config);
+}
+
+void AdaptiveOversampling::configure(const AdaptiveOversamplingConfig& config) {
+  _config = config;
+  if (_config.blockSamples < MIN_BLOCK_SAMPLES) {
+    _config.blockSamples = MIN_BLOCK_SAMPLES;
+  }
+  _boundsApplied = false;
+  reset();
+}
+
+void AdaptiveOversampling::reset() {
+  for (size_t c = 0; c < CHANNELS; ++c) {
+    _sumSqDiff[c] = 0;
+  }
+  _samples = 0;
+}
+
+Status AdaptiveOversampling::update(BME280& device, const CompensatedSample& sample) {
+  if (!_boundsApplied) {
+    return _applyBounds(device);
+  }
+  if (_skipNext) {
+    _skipNext = false;
+    return Status::Ok();
+  }
+
+  int32_t values[CHANNELS];
+  sampleValues(sample, values);
+  if (_samples > 0) {
+    for (size_t c = 0; c < CHANNELS; ++c) {
+      const int64_t d = static_cast<int64_t>(values[c]) - _previous[c];
+      _sumSqDiff[c] += static_cast<uint64_t>(d * d);
+    }
+  }
+  for (size_t c = 0; c < CHANNELS; ++c) {
+    _previous[c] = values[c];
+  }
+  _samples++;
+
+  if (_samples < _config.blockSamples) {
+    return Status::Ok();
+  }
+  return _finishBlock(device);
+}
+
+Status AdaptiveOversampling::_applyBounds(BME280& device) {
+  ConfigBatch batch;
+  Status st = currentSettings(device, batch);
+  if (!st.ok()) {
+    return st;
+  }
+
+  const Oversampling osrsT = clampOversampling(_config.temperature, batch.osrsT);
+  const Oversampling osrsP = clampOversampling(_config.pressure, batch.osrsP);
+  const Oversampling osrsH = clampOversampling(_config.humidity, batch.osrsH);
+  if (osrsT != batch.osrsT || osrsP != batch.osrsP || osrsH != batch.osrsH) {
+    batch.osrsT = osrsT;
+    batch.osrsP = osrsP;
+    batch.osrsH = osrsH;
+    st = device.setConfigBatch(batch);
+    if (!st.ok()) {
+      return st;
+    }
+  }
+  _boundsApplied = true;
+  return Status::Ok();
+}
+
+Status AdaptiveOversampling::_finishBlock(BME280& device) {
+  // E[(x[i] - x[i-1])^2] = 2 * noise variance for white noise on a slow signal
+  const uint64_t diffs = static_cast<uint64_t>(_samples - 1);
+  _estimate.temperature = _sumSqDiff[0] / (2 * diffs);
+  _estimate.pressure = _sumSqDiff[1] / (2 * diffs);
+  _estimate.humidity = _sumSqDiff[2] / (2 * diffs);
+  reset();
+
+  ConfigBatch batch;
+  Status st = currentSettings(device, batch);
+  if (!st.ok()) {
+    return st;
+  }
+
+  const Oversampling osrsT = stepOversampling(_config.temperature, batch.osrsT,
+                                              _estimate.temperature);
+  const Oversampling osrsP = stepOversampling(_config.pressure, batch.osrsP, _estimate.pressure);
+  const Oversampling osrsH = stepOversampling(_config.humidity, batch.osrsH, _estimate.humidity);
+  if (osrsT == batch.osrsT && osrsP == batch.osrsP && osrsH == batch.osrsH) {
+    return Status::Ok();
+  }
+
+  batch.osrsT = osrsT;
+  batch.osrsP = osrsP;
+  batch.osrsH = osrsH;
+  st = device.setConfigBatch(batch);
+  if (!st.ok()) {
+    return st;
+  }
+  _adjustments++;
+  _skipNext = true;
+  return Status::Ok();
+}
+
+} // namespace BME280
@@ -7,16 +7,41 @@
 
 #include <Arduino.h>
 #include <cstring>
-#include <limits>
 
 namespace BME280 {
 namespace {
 
-static constexpr size_t MAX_WRITE_LEN = 16;
+static constexpr size_t MAX_WRITE_PAIRS = 8;
 static constexpr uint32_t RESET_TIMEOUT_MS = 10;
+static constexpr uint32_t RESET_POLL_INTERVAL_MS = 1;
 static constexpr uint16_t RESET_MAX_POLLS = 255;
-static constexpr uint32_t MEASUREMENT_MARGIN_US = 1000;
-static constexpr int64_t HUMIDITY_MAX_X4096 = 419430400;
+static constexpr uint8_t STANDBY_SLACK_SHIFT = 4;  // +1/16 for standby oscillator tolerance
+
+static bool isValidChannelFilter(const ChannelFilterConfig& config) {
+  return (config.median == MedianTaps::OFF || config.median == MedianTaps::TAPS_3 ||
+          config.median == MedianTaps::TAPS_5) &&
+         config.iirShift <= SAMPLE_IIR_MAX_SHIFT;
+}
+
+static bool isValidSampleFilter(const SampleFilterConfig& config) {
+  return isValidChannelFilter(config.temperature) && isValidChannelFilter(config.pressure) &&
+         isValidChannelFilter(config.humidity);
+}
+
+static bool isValidRecovery(const RecoveryPolicy& policy) {
+  return !policy.enabled ||
+         (policy.initialMs > 0 && policy.maxMs >= policy.initialMs &&
+          policy.maxMs <= RECOVERY_MAX_BACKOFF_MS && policy.jitterPct <= 100);
+}
+
+/// True if |value - reference| >= band (band 0 never triggers)
+static bool exceedsBand(int64_t value, int64_t reference, uint32_t band) {
+  if (band == 0) {
+    return false;
+  }
+  const int64_t diff = (value > reference) ? value - reference : reference - value;
+  return diff >= static_cast<int64_t>(band);
+}
 
 static bool deadlineReached(uint32_t nowMs, uint32_t deadlineMs) {
   return static_cast<int32_t>(nowMs - deadlineMs) >= 0;
@@ -38,6 +63,21 @@ static uint8_t standbyToReg(Standby standby) {
   return static_cast<uint8_t>(standby) & 0x07;
 }
 
+/// Standby time rounded up to whole milliseconds
+static uint32_t standbyToMs(Standby standby) {
+  switch (standby) {
+    case Standby::MS_0_5: return 1;
+    case Standby::MS_62_5: return 63;
+    case Standby::MS_125: return 125;
+    case Standby::MS_250: return 250;
+    case Standby::MS_500: return 500;
+    case Standby::MS_1000: return 1000;
+    case Standby::MS_10: return 10;
+    case Standby::MS_20: return 20;
+    default: return 1000;
+  }
+}
+
 static uint8_t osrsMultiplier(Oversampling osrs) {
   switch (osrs) {
     case Oversampling::SKIP: return 0;
@@ -55,6 +95,12 @@ static bool isValidOversampling(Oversampling osrs) {
   return value <= 5;
 }
 
+/// Channels compiled out (Features.h) only accept SKIP
+static bool isChannelAvailable(Oversampling osrsP, Oversampling osrsH) {
+  return (BME280_ENABLE_PRESSURE || osrsP == Oversampling::SKIP) &&
+         (BME280_ENABLE_HUMIDITY || osrsH == Oversampling::SKIP);
+}
+
 static bool isValidFilter(Filter filter) {
   const uint8_t value = filterToReg(filter);
   return value <= 4;
@@ -79,9 +125,15 @@ static uint8_t buildCtrlMeas(Oversampling osrsT, Oversampling osrsP, Mode mode)
                               (modeToReg(mode) << cmd::BIT_CTRL_MEAS_MODE));
 }
 
-static uint8_t buildConfig(Standby standby, Filter filter) {
+static uint8_t buildConfig(Standby standby, Filter filter, bool spi3w) {
   return static_cast<uint8_t>((standbyToReg(standby) << cmd::BIT_CONFIG_T_SB) |
-                              (filterToReg(filter) << cmd::BIT_CONFIG_FILTER));
+                              (filterToReg(filter) << cmd::BIT_CONFIG_FILTER) |
+                              ((spi3w ? 1u : 0u) << cmd::BIT_CONFIG_SPI3W_EN));
+}
+
+/// ctrl_meas value the device settles in: FORCED conversions return to SLEEP
+static uint8_t settledCtrlMeas(Oversampling osrsT, Oversampling osrsP, Mode mode) {
+  return buildCtrlMeas(osrsT, osrsP, mode == Mode::NORMAL ? Mode::NORMAL : Mode::SLEEP);
 }
 
 static int16_t signExtend12(int16_t value) {
@@ -91,9 +143,45 @@ static int16_t signExtend12(int16_t value) {
   return value;
 }
 
+// Calibration blob layout (see CalibrationBlob)
+static constexpr uint8_t BLOB_VERSION = 1;
+static constexpr size_t BLOB_IDX_VERSION = 0;
+static constexpr size_t BLOB_IDX_TP = 1;
+static constexpr size_t BLOB_TP_LEN = 24;  // 0x88..0x9F
+static constexpr size_t BLOB_IDX_H1 = BLOB_IDX_TP + BLOB_TP_LEN;
+static constexpr size_t BLOB_IDX_H = BLOB_IDX_H1 + 1;
+static constexpr size_t BLOB_IDX_CRC = BLOB_IDX_H + cmd::REG_CALIB_H_LEN;
+static_assert(RAW_FRAME_DATA_LEN == cmd::DATA_LEN, "RawFrame must hold the data burst");
+static_assert(BLOB_IDX_CRC + 2 == CALIBRATION_BLOB_SIZE, "Calibration blob layout mismatch");
+
+static uint16_t crc16Ccitt(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; ++i) {
+    crc = static_cast<uint16_t>(crc ^ (static_cast<uint16_t>(data[i]) << 8));
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                           : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static void putLe16(uint8_t* dst, uint16_t value) {
+  dst[0] = static_cast<uint8_t>(value & 0xFF);
+  dst[1] = static_cast<uint8_t>(value >> 8);
+}
+
 }  // namespace
 
 Status BME280::begin(const Config& config) {
+  return _begin(config, nullptr);
+}
+
+Status BME280::begin(const Config& config, const CalibrationBlob& blob) {
+  return _begin(config, &blob);
+}
+
+Status BME280::_begin(const Config& config, const CalibrationBlob* blob) {
   _initialized = false;
   _driverState = DriverState::UNINIT;
 
@@ -103,22 +191,53 @@ Status BME280::begin(const Config& config) {
   _consecutiveFailures = 0;
   _totalFailures = 0;
   _totalSuccess = 0;
+  _configDriftCount = 0;
+  _recoveryScheduled = false;
+  _nextRecoveryMs = 0;
+  _recoveryBackoffMs = 0;
+  _recoveryAttempts = 0;
+  _recoveries = 0;
 
   _measurementRequested = false;
   _measurementReady = false;
   _measurementStartMs = 0;
+  _measurementStartUs = 0;
+  _nextSampleDueMs = 0;
+  _resetStep = ResetStep::IDLE;
+  _resetResult = Status::Ok();
+  _asyncOp = AsyncOp::NONE;
+  _triggerPending = false;
+  _asyncDone.store(false, std::memory_order_relaxed);
   _tFine = 0;
   _rawSample = RawSample{};
   _compSample = CompensatedSample{};
-
-  if (config.i2cWrite == nullptr || config.i2cWriteRead == nullptr) {
-    return Status::Error(Err::INVALID_CONFIG, "I2C callbacks not set");
+  _shadowValid = false;
+  _deliveredValid = false;
+  _lastDeliveredMs = 0;
+  _suppressedSamples = 0;
+#if BME280_ENABLE_INSTRUMENTATION
+  resetBusStats();
+#endif
+
+  if (config.bus == BusType::I2C) {
+    if (config.i2cWrite == nullptr || config.i2cWriteRead == nullptr) {
+      return Status::Error(Err::INVALID_CONFIG, "I2C callbacks not set");
+    }
+    if (config.i2cAddress != 0x76 && config.i2cAddress != 0x77) {
+      return Status::Error(Err::INVALID_CONFIG, "Invalid I2C address");
+    }
+  } else if (config.bus == BusType::SPI_4WIRE || config.bus == BusType::SPI_3WIRE) {
+    if (config.spiWrite == nullptr || config.spiWriteRead == nullptr) {
+      return Status::Error(Err::INVALID_CONFIG, "SPI callbacks not set");
+    }
+    if (config.i2cSubmit != nullptr) {
+      return Status::Error(Err::INVALID_CONFIG, "Async transport requires I2C");
+    }
+  } else {
+    return Status::Error(Err::INVALID_CONFIG, "Invalid bus type");
   }
   if (config.i2cTimeoutMs == 0) {
-    return Status::Error(Err::INVALID_CONFIG, "I2C timeout must be > 0");
-  }
-  if (config.i2cAddress != 0x76 && config.i2cAddress != 0x77) {
-    return Status::Error(Err::INVALID_CONFIG, "Invalid I2C address");
+    return Status::Error(Err::INVALID_CONFIG, "Bus timeout must be > 0");
   }
   if (!isValidOversampling(config.osrsT) ||
       !isValidOversampling(config.osrsP) ||
@@ -128,14 +247,34 @@ Status BME280::begin(const Config& config) {
       !isValidMode(config.mode)) {
     return Status::Error(Err::INVALID_CONFIG, "Invalid configuration value");
   }
+  if (!isChannelAvailable(config.osrsP, config.osrsH)) {
+    return Status::Error(Err::INVALID_CONFIG, "Channel disabled at compile time");
+  }
+  if (!isValidSampleFilter(config.sampleFilter)) {
+    return Status::Error(Err::INVALID_CONFIG, "Invalid sample filter");
+  }
+  if (!isValidRecovery(config.recovery)) {
+    return Status::Error(Err::INVALID_CONFIG, "Invalid recovery policy");
+  }
 
   _config = config;
+  _sampleFilter.configure(_config.sampleFilter);
+  _inTick = false;
+  // Per-instance jitter seed, so sensors that fail together do not retry in step
+  _jitterState = (_clockUs() ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)) ^
+                  (static_cast<uint32_t>(_config.i2cAddress) << 24)) | 1U;
   if (_config.offlineThreshold == 0) {
     _config.offlineThreshold = 1;
   }
 
+  // 3-wire SPI cannot read until spi3w_en is set; the write works in either mode
+  Status st = _enableSpi3wRaw();
+  if (!st.ok()) {
+    return Status::Error(Err::DEVICE_NOT_FOUND, "Device not responding", st.detail);
+  }
+
   uint8_t chipId = 0;
-  Status st = _readRegisterRaw(cmd::REG_CHIP_ID, chipId);
+  st = _readRegisterRaw(cmd::REG_CHIP_ID, chipId);
   if (!st.ok()) {
     return Status::Error(Err::DEVICE_NOT_FOUND, "Device not responding", st.detail);
   }
@@ -143,7 +282,7 @@ Status BME280::begin(const Config& config) {
     return Status::Error(Err::CHIP_ID_MISMATCH, "Chip ID mismatch", chipId);
   }
 
-  st = _readCalibration();
+  st = (blob != nullptr) ? _loadCalibrationBlob(*blob) : _readCalibration();
   if (!st.ok()) {
     return st;
   }
@@ -163,7 +302,31 @@ Status BME280::begin(const Config& config) {
 }
 
 void BME280::tick(uint32_t nowMs) {
-  if (!_initialized || !_measurementRequested) {
+  if (!_initialized) {
+    return;
+  }
+
+  // Health timestamps inside tick() reuse nowMs instead of reading the clock
+  _tickNowMs = nowMs;
+  _inTick = true;
+  if (_config.recovery.enabled) {
+    _tickRecovery(nowMs);
+  }
+  if (_resetStep != ResetStep::IDLE) {
+    _tickReset(nowMs);
+  } else {
+    _tickMeasurement(nowMs);
+  }
+  _inTick = false;
+}
+
+void BME280::_tickMeasurement(uint32_t nowMs) {
+  if (_asyncOp != AsyncOp::NONE) {
+    _tickAsyncCompletion(nowMs);
+    return;
+  }
+
+  if (!_measurementRequested) {
     return;
   }
 
@@ -177,17 +340,52 @@ void BME280::tick(uint32_t nowMs) {
     return;
   }
 
+  if (_frames != nullptr && _frameCount >= _frameCapacity) {
+    // Frame buffer full: no bus access until the caller drains it
+    if (_framesDropped < UINT32_MAX) {
+      _framesDropped++;
+    }
+    _measurementRequested = false;
+    return;
+  }
+
+  if (_triggerPending) {
+    // Retry a FORCED trigger whose write failed
+    _rearmForced();
+    return;
+  }
+
   if (_config.mode == Mode::FORCED) {
-    const uint32_t deadline = _measurementStartMs + estimateMeasurementTimeMs();
-    const bool deadlineFromTick = deadlineReached(nowMs, deadline);
-    const bool deadlineFromMillis = deadlineReached(millis(), deadline);
-    if (!deadlineFromTick && !deadlineFromMillis) {
+    // Gate on the microsecond clock to avoid rounding the wait up to whole ms.
+    // Elapsed time, not a wrapped deadline, so a long stall still reads out
+    const uint64_t waitUs = static_cast<uint64_t>(estimateMeasurementTimeUs(MeasurementTime::MAX)) +
+                            _config.measurementMarginUs;
+    if (_forcedElapsedUs() < waitUs) {
       return;
     }
+  } else if (!deadlineReached(nowMs, _nextSampleDueMs)) {
+    return;
   }
 
+  if (_config.i2cSubmit != nullptr) {
+    // Asynchronous transports always use the fused burst: one transfer per sample
+    _asyncTx[0] = cmd::REG_FUSED_START;
+    const Status st = _i2cSubmitTracked(AsyncOp::READ, _asyncTx, 1, _asyncRx, sizeof(_asyncRx));
+    if (st.code != Err::IN_PROGRESS && _driverState == DriverState::OFFLINE) {
+      _measurementRequested = false;
+    }
+    return;
+  }
+
+  // In NORMAL mode a full period has elapsed since the last read, so at least one
+  // conversion completed and the shadowed data registers are fresh: no status poll
   bool measuring = false;
-  Status st = isMeasuring(measuring);
+  Status st = Status::Ok();
+  if (_config.fusedRead) {
+    st = _readFused(measuring);
+  } else if (_config.mode == Mode::FORCED) {
+    st = isMeasuring(measuring);
+  }
   if (!st.ok()) {
     if (_driverState == DriverState::OFFLINE) {
       _measurementRequested = false;
@@ -198,30 +396,321 @@ void BME280::tick(uint32_t nowMs) {
     return;
   }
 
-  st = _readRawData();
-  if (!st.ok()) {
+  if (!_config.fusedRead) {
+    st = _readRawData();
+    if (!st.ok()) {
+      if (_driverState == DriverState::OFFLINE) {
+        _measurementRequested = false;
+      }
+      return;
+    }
+  }
+
+  _publishSample(nowMs);
+}
+
+void BME280::_tickRecovery(uint32_t nowMs) {
+  if (_driverState != DriverState::OFFLINE) {
+    // Back online (a transfer succeeded or recover() was called): the next outage
+    // starts over at initialMs
+    _recoveryScheduled = false;
+    return;
+  }
+  if (_resetStep != ResetStep::IDLE || _asyncOp != AsyncOp::NONE) {
+    return;
+  }
+  if (!_recoveryScheduled) {
+    _recoveryBackoffMs = _config.recovery.initialMs;
+    _nextRecoveryMs = nowMs + _recoveryDelayMs();
+    _recoveryScheduled = true;
+    return;
+  }
+  if (!deadlineReached(nowMs, _nextRecoveryMs)) {
+    return;
+  }
+
+  if (_recoveryAttempts < UINT32_MAX) {
+    _recoveryAttempts++;
+  }
+
+  // Untracked probe: a missing device does not add to the health counters
+  uint8_t chipId = 0;
+  Status st = _enableSpi3wRaw();
+  if (st.ok()) {
+    st = _readRegisterRaw(cmd::REG_CHIP_ID, chipId);
+  }
+  if (st.ok() && chipId == cmd::CHIP_ID_BME280) {
+    // The device may have been power-cycled: write every register again.
+    // The tracked writes return the driver to READY.
+    _shadowValid = false;
+    st = _applyConfig();
+    if (st.ok()) {
+      if (_recoveries < UINT32_MAX) {
+        _recoveries++;
+      }
+      _recoveryScheduled = false;
+      return;
+    }
+  }
+
+  const uint32_t maxMs = _config.recovery.maxMs;
+  _recoveryBackoffMs = (_recoveryBackoffMs > maxMs / 2) ? maxMs : 2 * _recoveryBackoffMs;
+  _nextRecoveryMs = nowMs + _recoveryDelayMs();
+}
+
+uint32_t BME280::_recoveryDelayMs() {
+  const uint32_t pct = _config.recovery.jitterPct;
+  if (pct == 0) {
+    return _recoveryBackoffMs;
+  }
+
+  // xorshift32
+  uint32_t x = _jitterState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  _jitterState = x;
+
+  // At most 2 * RECOVERY_MAX_BACKOFF_MS, well inside the wraparound-safe range
+  const uint32_t percent = 100 - pct + x % (2 * pct + 1);  // 100 +/- pct
+  return static_cast<uint32_t>(static_cast<uint64_t>(_recoveryBackoffMs) * percent / 100);
+}
+
+void BME280::_tickAsyncCompletion(uint32_t nowMs) {
+  Status result = Status::Ok();
+  if (!_asyncPollComplete(result)) {
+    return;
+  }
+
+  const AsyncOp op = _asyncOp;
+  _asyncOp = AsyncOp::NONE;
+  result = _i2cCompleteTracked(result);
+
+  if (!result.ok()) {
+    if (op == AsyncOp::TRIGGER) {
+      _triggerPending = true;
+    }
     if (_driverState == DriverState::OFFLINE) {
       _measurementRequested = false;
+      _triggerPending = false;
     }
     return;
   }
 
-  st = _compensate();
-  if (!st.ok()) {
-    _measurementRequested = false;
+  if (op != AsyncOp::READ || !_measurementRequested) {
+    return;
+  }
+
+  bool busy = false;
+  const Status st = _processFused(_asyncRx, busy);
+  if (!st.ok() || busy) {
     return;
   }
 
-  _measurementReady = true;
+  _publishSample(nowMs);
+}
+
+void BME280::_publishSample(uint32_t nowMs) {
+  if (_config.mode == Mode::NORMAL) {
+    _nextSampleDueMs = nowMs + _normalPeriodMs();
+  }
   _measurementRequested = false;
+
+  // Re-arm right after the readout, before any processing stage can bail out
+  if (_config.mode == Mode::FORCED && _config.forcedAutoRearm) {
+    _rearmForced();
+  }
+
+  if (_frames != nullptr) {
+    // Capture mode: commit the frame, compensation is deferred to the caller
+    _frames[_frameCount].timestampMs = nowMs;
+    _frameCount++;
+  } else if (_frameRing != nullptr) {
+    _ringFrame.timestampMs = nowMs;
+    _frameRing->push(_ringFrame);
+  } else {
+    const Status st = _compensate();
+    if (!st.ok()) {
+      return;
+    }
+
+    if (_config.sampleFilter.active()) {
+      _sampleFilter.apply(_compSample);
+    }
+
+    if (_windowStats != nullptr) {
+      _windowStats->add(_compSample, nowMs);
+    }
+
+    if (_passesDeadband(nowMs)) {
+      _deliveredValid = true;
+      _lastDeliveredMs = nowMs;
+      _lastDelivered = _compSample;
+      _measurementReady = true;
+
+      if (_sampleRing != nullptr) {
+        TimestampedSample item;
+        item.timestampMs = nowMs;
+        item.sample = _compSample;
+        _sampleRing->push(item);
+      }
+      if (_config.sampleCallback != nullptr) {
+        _config.sampleCallback(_compSample, nowMs, _config.sampleUser);
+      }
+    } else if (_suppressedSamples < UINT32_MAX) {
+      _suppressedSamples++;
+    }
+  }
+}
+
+bool BME280::_passesDeadband(uint32_t nowMs) const {
+  const Deadband& band = _config.deadband;
+  if (!_deliveredValid || !band.active()) {
+    return true;
+  }
+  if (band.maxSilenceMs != 0 && nowMs - _lastDeliveredMs >= band.maxSilenceMs) {
+    return true;
+  }
+  return exceedsBand(_compSample.tempC_x100, _lastDelivered.tempC_x100, band.tempC_x100) ||
+         exceedsBand(_compSample.pressurePa, _lastDelivered.pressurePa, band.pressurePa) ||
+         exceedsBand(_compSample.humidityPct_x1024, _lastDelivered.humidityPct_x1024,
+                     band.humidityPct_x1024);
+}
+
+Status BME280::setSampleFilter(const SampleFilterConfig& config) {
+  if (!isValidSampleFilter(config)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid sample filter");
+  }
+  _config.sampleFilter = config;
+  _sampleFilter.configure(config);
+  return Status::Ok();
+}
+
+void BME280::setDeadband(const Deadband& deadband) {
+  _config.deadband = deadband;
+  _deliveredValid = false;
+}
+
+void BME280::_rearmForced() {
+  // Start the next conversion without a status pre-read. A failed trigger stays
+  // pending and tick() retries it until it succeeds or the driver goes OFFLINE.
+  Status st = Status::Ok();
+  if (_config.i2cSubmit != nullptr) {
+    st = _submitAsyncTrigger();
+  } else {
+    _triggerPending = false;
+    st = _triggerForced();
+    if (st.code != Err::IN_PROGRESS && _driverState != DriverState::OFFLINE) {
+      _triggerPending = true;
+    }
+  }
+  _measurementRequested = (st.code == Err::IN_PROGRESS) || _triggerPending;
+}
+
+Status BME280::_triggerForced() {
+  const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, Mode::FORCED);
+  const Status st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
+  if (!st.ok()) {
+    return st;
+  }
+
+  _measurementRequested = true;
+  _measurementStartUs = _clockUs64();
+  _measurementStartMs = _nowMs();
+  return Status::Error(Err::IN_PROGRESS, "Measurement started");
+}
+
+Status BME280::_submitAsyncTrigger() {
+  _triggerPending = false;
+  _asyncTx[0] = cmd::REG_CTRL_MEAS;
+  _asyncTx[1] = buildCtrlMeas(_config.osrsT, _config.osrsP, Mode::FORCED);
+  const Status st = _i2cSubmitTracked(AsyncOp::TRIGGER, _asyncTx, 2, nullptr, 0);
+  if (st.code != Err::IN_PROGRESS) {
+    if (_driverState != DriverState::OFFLINE) {
+      _triggerPending = true;
+    }
+    return st;
+  }
+
+  _measurementStartUs = _clockUs64();
+  _measurementStartMs = _nowMs();
+  return st;
+}
+
+void BME280::onTransferComplete(const Status& result) {
+  _asyncResult = result;
+  _asyncDone.store(true, std::memory_order_release);
+}
+
+Status BME280::attachFrameBuffer(RawFrame* buf, size_t capacity) {
+  if (buf == nullptr || capacity == 0) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid frame buffer");
+  }
+  if (_frameRing != nullptr) {
+    return Status::Error(Err::BUSY, "Frame ring attached");
+  }
+  if (_asyncOp != AsyncOp::NONE) {
+    return Status::Error(Err::BUSY, "Transfer in flight");
+  }
+
+  _frames = buf;
+  _frameCapacity = capacity;
+  _frameCount = 0;
+  _framesDropped = 0;
+  _measurementReady = false;
+  return Status::Ok();
+}
+
+Status BME280::attachSampleRing(SpscRing<TimestampedSample>* ring) {
+  if (ring == nullptr) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid sample ring");
+  }
+  _sampleRing = ring;
+  return Status::Ok();
+}
+
+Status BME280::attachWindowStats(WindowStats* stats) {
+  if (stats == nullptr) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid window stats");
+  }
+  _windowStats = stats;
+  return Status::Ok();
+}
+
+Status BME280::attachFrameRing(SpscRing<RawFrame>* ring) {
+  if (ring == nullptr) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid frame ring");
+  }
+  if (_frames != nullptr) {
+    return Status::Error(Err::BUSY, "Frame buffer attached");
+  }
+  _frameRing = ring;
+  _measurementReady = false;
+  return Status::Ok();
+}
+
+void BME280::detachFrameBuffer() {
+  // An in-flight read still targets the internal buffer, so detaching is safe
+  _frames = nullptr;
+  _frameCapacity = 0;
+  _frameCount = 0;
+}
+
+void BME280::clearFrames() {
+  _frameCount = 0;
 }
 
 void BME280::end() {
   _initialized = false;
   _driverState = DriverState::UNINIT;
+  _shadowValid = false;
+  _resetStep = ResetStep::IDLE;
+  _asyncOp = AsyncOp::NONE;
+  _triggerPending = false;
   _measurementRequested = false;
   _measurementReady = false;
   _measurementStartMs = 0;
+  _measurementStartUs = 0;
   _tFine = 0;
   _rawSample = RawSample{};
   _compSample = CompensatedSample{};
@@ -232,8 +721,18 @@ Status BME280::probe() {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
   }
 
+  // 3-wire SPI cannot read until spi3w_en is set; the write works in either mode.
+  // With valid shadows spi3w_en is already set, so the probe stays read-only.
+  Status st = Status::Ok();
+  if (!_shadowValid) {
+    st = _enableSpi3wRaw();
+    if (!st.ok()) {
+      return Status::Error(Err::DEVICE_NOT_FOUND, "Device not responding", st.detail);
+    }
+  }
+
   uint8_t chipId = 0;
-  Status st = _readRegisterRaw(cmd::REG_CHIP_ID, chipId);
+  st = _readRegisterRaw(cmd::REG_CHIP_ID, chipId);
   if (!st.ok()) {
     return Status::Error(Err::DEVICE_NOT_FOUND, "Device not responding", st.detail);
   }
@@ -266,16 +765,37 @@ Status BME280::requestMeasurement() {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
   }
   if (_driverState == DriverState::OFFLINE) {
-    return Status::Error(Err::BUSY, "Driver is offline; call recover()");
+    return Status::Error(Err::BUSY, "Driver is offline; call recover() or enable Config::recovery");
+  }
+  if (_resetStep != ResetStep::IDLE) {
+    return Status::Error(Err::BUSY, "Reset in progress");
   }
   if (_config.mode == Mode::SLEEP) {
     return Status::Error(Err::INVALID_PARAM, "Device is in sleep mode");
   }
-  if (_measurementRequested && !_measurementReady) {
+  if (_measurementRequested && _config.mode == Mode::FORCED && _config.forcedAutoRearm) {
+    // forcedAutoRearm already triggered the next conversion
+    return Status::Error(Err::IN_PROGRESS, "Measurement armed");
+  }
+  if (_measurementRequested) {
     return Status::Error(Err::BUSY, "Measurement in progress");
   }
 
   _measurementReady = false;
+  _triggerPending = false;
+
+  if (_config.mode == Mode::FORCED && _config.i2cSubmit != nullptr) {
+    if (_asyncOp != AsyncOp::NONE) {
+      return Status::Error(Err::BUSY, "Transfer in flight");
+    }
+    const Status st = _submitAsyncTrigger();
+    if (st.code != Err::IN_PROGRESS) {
+      _triggerPending = false;
+      return st;
+    }
+    _measurementRequested = true;
+    return Status::Error(Err::IN_PROGRESS, "Measurement started");
+  }
 
   if (_config.mode == Mode::FORCED) {
     bool measuring = false;
@@ -287,23 +807,29 @@ Status BME280::requestMeasurement() {
       return Status::Error(Err::BUSY, "Device is measuring");
     }
 
-    const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, Mode::FORCED);
-    st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-    if (!st.ok()) {
-      return st;
-    }
-
-    _measurementRequested = true;
-    _measurementStartMs = millis();
-
-    return Status::Error(Err::IN_PROGRESS, "Measurement started");
+    return _triggerForced();
   }
 
   _measurementRequested = true;
   return Status::Error(Err::IN_PROGRESS, "Measurement scheduled");
 }
 
+#if BME280_ENABLE_FLOAT_API
 Status BME280::getMeasurement(Measurement& out) {
+  CompensatedSample sample;
+  const Status st = getMeasurement(sample);
+  if (!st.ok()) {
+    return st;
+  }
+
+  out.temperatureC = static_cast<float>(sample.tempC_x100) / 100.0f;
+  out.pressurePa = static_cast<float>(sample.pressurePa);
+  out.humidityPct = static_cast<float>(sample.humidityPct_x1024) / 1024.0f;
+  return Status::Ok();
+}
+#endif
+
+Status BME280::getMeasurement(CompensatedSample& out) {
   if (!_initialized) {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
   }
@@ -311,10 +837,7 @@ Status BME280::getMeasurement(Measurement& out) {
     return Status::Error(Err::MEASUREMENT_NOT_READY, "Measurement not ready");
   }
 
-  out.temperatureC = static_cast<float>(_compSample.tempC_x100) / 100.0f;
-  out.pressurePa = static_cast<float>(_compSample.pressurePa);
-  out.humidityPct = static_cast<float>(_compSample.humidityPct_x1024) / 1024.0f;
-
+  out = _compSample;
   _measurementReady = false;
   return Status::Ok();
 }
@@ -348,30 +871,11 @@ Status BME280::getCalibration(Calibration& out) const {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
   }
 
-  out.digT1 = _digT1;
-  out.digT2 = _digT2;
-  out.digT3 = _digT3;
-
-  out.digP1 = _digP1;
-  out.digP2 = _digP2;
-  out.digP3 = _digP3;
-  out.digP4 = _digP4;
-  out.digP5 = _digP5;
-  out.digP6 = _digP6;
-  out.digP7 = _digP7;
-  out.digP8 = _digP8;
-  out.digP9 = _digP9;
-
-  out.digH1 = _digH1;
-  out.digH2 = _digH2;
-  out.digH3 = _digH3;
-  out.digH4 = _digH4;
-  out.digH5 = _digH5;
-  out.digH6 = _digH6;
-
+  out = _calib;
   return Status::Ok();
 }
 
+#if BME280_ENABLE_DIAGNOSTICS
 Status BME280::readCalibrationRaw(CalibrationRaw& out) {
   if (!_initialized) {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
@@ -381,13 +885,49 @@ Status BME280::readCalibrationRaw(CalibrationRaw& out) {
   if (!st.ok()) {
     return st;
   }
+  out.h1 = out.tp[cmd::CALIB_TP_IDX_H1];
 
-  st = readRegs(cmd::REG_CALIB_H1, &out.h1, 1);
-  if (!st.ok()) {
-    return st;
+  return readRegs(cmd::REG_CALIB_H_START, out.h, sizeof(out.h));
+}
+#endif
+
+Status BME280::exportCalibration(CalibrationBlob& out) const {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
   }
 
-  return readRegs(cmd::REG_CALIB_H_START, out.h, sizeof(out.h));
+  uint8_t* d = out.data;
+  d[BLOB_IDX_VERSION] = BLOB_VERSION;
+
+  uint8_t* tp = &d[BLOB_IDX_TP];
+  putLe16(&tp[0], _calib.digT1);
+  putLe16(&tp[2], static_cast<uint16_t>(_calib.digT2));
+  putLe16(&tp[4], static_cast<uint16_t>(_calib.digT3));
+  putLe16(&tp[6], _calib.digP1);
+  putLe16(&tp[8], static_cast<uint16_t>(_calib.digP2));
+  putLe16(&tp[10], static_cast<uint16_t>(_calib.digP3));
+  putLe16(&tp[12], static_cast<uint16_t>(_calib.digP4));
+  putLe16(&tp[14], static_cast<uint16_t>(_calib.digP5));
+  putLe16(&tp[16], static_cast<uint16_t>(_calib.digP6));
+  putLe16(&tp[18], static_cast<uint16_t>(_calib.digP7));
+  putLe16(&tp[20], static_cast<uint16_t>(_calib.digP8));
+  putLe16(&tp[22], static_cast<uint16_t>(_calib.digP9));
+
+  d[BLOB_IDX_H1] = _calib.digH1;
+
+  // Re-pack H4/H5 into the 12-bit register layout of 0xE4..0xE6
+  const uint16_t h4 = static_cast<uint16_t>(_calib.digH4) & 0x0FFF;
+  const uint16_t h5 = static_cast<uint16_t>(_calib.digH5) & 0x0FFF;
+  uint8_t* h = &d[BLOB_IDX_H];
+  putLe16(&h[0], static_cast<uint16_t>(_calib.digH2));
+  h[2] = _calib.digH3;
+  h[3] = static_cast<uint8_t>(h4 >> 4);
+  h[4] = static_cast<uint8_t>((h4 & 0x0F) | ((h5 & 0x0F) << 4));
+  h[5] = static_cast<uint8_t>(h5 >> 4);
+  h[6] = static_cast<uint8_t>(_calib.digH6);
+
+  putLe16(&d[BLOB_IDX_CRC], crc16Ccitt(d, BLOB_IDX_CRC));
+  return Status::Ok();
 }
 
 Status BME280::setMode(Mode mode) {
@@ -398,17 +938,8 @@ Status BME280::setMode(Mode mode) {
     return Status::Error(Err::INVALID_PARAM, "Invalid mode");
   }
 
-  const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, mode);
-  Status st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-  if (!st.ok()) {
-    return st;
-  }
-
-  _config.mode = mode;
-  if (mode == Mode::SLEEP) {
-    _measurementRequested = false;
-  }
-  return Status::Ok();
+  return _applySettings(_config.osrsT, _config.osrsP, _config.osrsH,
+                        _config.filter, _config.standby, mode);
 }
 
 Status BME280::getMode(Mode& out) const {
@@ -427,13 +958,8 @@ Status BME280::setOversamplingT(Oversampling osrs) {
     return Status::Error(Err::INVALID_PARAM, "Invalid oversampling");
   }
 
-  const uint8_t ctrlMeas = buildCtrlMeas(osrs, _config.osrsP, _config.mode);
-  Status st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-  if (!st.ok()) {
-    return st;
-  }
-  _config.osrsT = osrs;
-  return Status::Ok();
+  return _applySettings(osrs, _config.osrsP, _config.osrsH,
+                        _config.filter, _config.standby, _config.mode);
 }
 
 Status BME280::setOversamplingP(Oversampling osrs) {
@@ -444,13 +970,12 @@ Status BME280::setOversamplingP(Oversampling osrs) {
     return Status::Error(Err::INVALID_PARAM, "Invalid oversampling");
   }
 
-  const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, osrs, _config.mode);
-  Status st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-  if (!st.ok()) {
-    return st;
+  if (!isChannelAvailable(osrs, _config.osrsH)) {
+    return Status::Error(Err::INVALID_PARAM, "Pressure disabled at compile time");
   }
-  _config.osrsP = osrs;
-  return Status::Ok();
+
+  return _applySettings(_config.osrsT, osrs, _config.osrsH,
+                        _config.filter, _config.standby, _config.mode);
 }
 
 Status BME280::setOversamplingH(Oversampling osrs) {
@@ -461,20 +986,12 @@ Status BME280::setOversamplingH(Oversampling osrs) {
     return Status::Error(Err::INVALID_PARAM, "Invalid oversampling");
   }
 
-  const uint8_t ctrlHum = buildCtrlHum(osrs);
-  Status st = writeRegister(cmd::REG_CTRL_HUM, ctrlHum);
-  if (!st.ok()) {
-    return st;
+  if (!isChannelAvailable(_config.osrsP, osrs)) {
+    return Status::Error(Err::INVALID_PARAM, "Humidity disabled at compile time");
   }
 
-  const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, _config.mode);
-  st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-  if (!st.ok()) {
-    return st;
-  }
-
-  _config.osrsH = osrs;
-  return Status::Ok();
+  return _applySettings(_config.osrsT, _config.osrsP, osrs,
+                        _config.filter, _config.standby, _config.mode);
 }
 
 Status BME280::setFilter(Filter filter) {
@@ -485,29 +1002,8 @@ Status BME280::setFilter(Filter filter) {
     return Status::Error(Err::INVALID_PARAM, "Invalid filter");
   }
 
-  const uint8_t config = buildConfig(_config.standby, filter);
-  const uint8_t ctrlMeasSleep = buildCtrlMeas(_config.osrsT, _config.osrsP, Mode::SLEEP);
-  const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, _config.mode);
-
-  Status st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeasSleep);
-  if (!st.ok()) {
-    return st;
-  }
-  st = writeRegister(cmd::REG_CONFIG, config);
-  if (!st.ok()) {
-    const Status restoreSt = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-    if (!restoreSt.ok()) {
-      return restoreSt;
-    }
-    return st;
-  }
-  st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-  if (!st.ok()) {
-    return st;
-  }
-
-  _config.filter = filter;
-  return Status::Ok();
+  return _applySettings(_config.osrsT, _config.osrsP, _config.osrsH,
+                        filter, _config.standby, _config.mode);
 }
 
 Status BME280::setStandby(Standby standby) {
@@ -518,29 +1014,28 @@ Status BME280::setStandby(Standby standby) {
     return Status::Error(Err::INVALID_PARAM, "Invalid standby");
   }
 
-  const uint8_t config = buildConfig(standby, _config.filter);
-  const uint8_t ctrlMeasSleep = buildCtrlMeas(_config.osrsT, _config.osrsP, Mode::SLEEP);
-  const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, _config.mode);
+  return _applySettings(_config.osrsT, _config.osrsP, _config.osrsH,
+                        _config.filter, standby, _config.mode);
+}
 
-  Status st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeasSleep);
-  if (!st.ok()) {
-    return st;
+Status BME280::setConfigBatch(const ConfigBatch& batch) {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
   }
-  st = writeRegister(cmd::REG_CONFIG, config);
-  if (!st.ok()) {
-    const Status restoreSt = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-    if (!restoreSt.ok()) {
-      return restoreSt;
-    }
-    return st;
+  if (!isValidOversampling(batch.osrsT) ||
+      !isValidOversampling(batch.osrsP) ||
+      !isValidOversampling(batch.osrsH) ||
+      !isValidFilter(batch.filter) ||
+      !isValidStandby(batch.standby) ||
+      !isValidMode(batch.mode)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid configuration value");
   }
-  st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-  if (!st.ok()) {
-    return st;
+  if (!isChannelAvailable(batch.osrsP, batch.osrsH)) {
+    return Status::Error(Err::INVALID_PARAM, "Channel disabled at compile time");
   }
 
-  _config.standby = standby;
-  return Status::Ok();
+  return _applySettings(batch.osrsT, batch.osrsP, batch.osrsH,
+                        batch.filter, batch.standby, batch.mode);
 }
 
 Status BME280::getOversamplingT(Oversampling& out) const {
@@ -575,6 +1070,17 @@ Status BME280::getFilter(Filter& out) const {
   return Status::Ok();
 }
 
+Channels BME280::channels() const {
+  uint8_t set = static_cast<uint8_t>(Channels::T);
+  if (_config.osrsP != Oversampling::SKIP) {
+    set |= CHANNEL_PRESSURE;
+  }
+  if (_config.osrsH != Oversampling::SKIP) {
+    set |= CHANNEL_HUMIDITY;
+  }
+  return static_cast<Channels>(set & static_cast<uint8_t>(COMPILED_CHANNELS));
+}
+
 Status BME280::getStandby(Standby& out) const {
   if (!_initialized) {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
@@ -587,21 +1093,23 @@ Status BME280::softReset() {
   if (!_initialized) {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
   }
+  if (_resetStep != ResetStep::IDLE) {
+    return Status::Error(Err::BUSY, "Reset in progress");
+  }
 
-  _measurementRequested = false;
-  _measurementReady = false;
-  _measurementStartMs = 0;
-
-  Status st = writeRegister(cmd::REG_RESET, cmd::RESET_VALUE);
+  Status st = _writeReset();
   if (!st.ok()) {
     return st;
   }
 
-  const uint32_t deadline = millis() + RESET_TIMEOUT_MS;
+  const uint32_t deadline = _clockMs() + RESET_TIMEOUT_MS;
   bool resetDone = false;
   for (uint16_t poll = 0; poll < RESET_MAX_POLLS; ++poll) {
     uint8_t status = 0;
-    st = readRegister(cmd::REG_STATUS, status);
+    st = _enableSpi3wRaw();
+    if (st.ok()) {
+      st = readRegister(cmd::REG_STATUS, status);
+    }
     if (!st.ok()) {
       return st;
     }
@@ -609,7 +1117,7 @@ Status BME280::softReset() {
       resetDone = true;
       break;
     }
-    if (deadlineReached(millis(), deadline)) {
+    if (deadlineReached(_clockMs(), deadline)) {
       return Status::Error(Err::TIMEOUT, "Reset timeout");
     }
   }
@@ -628,6 +1136,114 @@ Status BME280::softReset() {
   return _applyConfig();
 }
 
+Status BME280::beginReset() {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
+  }
+  if (_resetStep != ResetStep::IDLE) {
+    return Status::Error(Err::BUSY, "Reset in progress");
+  }
+
+  Status st = _writeReset();
+  if (!st.ok()) {
+    _resetResult = st;
+    return st;
+  }
+
+  const uint32_t now = _nowMs();
+  _resetDeadlineMs = now + RESET_TIMEOUT_MS;
+  _resetNextPollMs = now + RESET_POLL_INTERVAL_MS;
+  _resetStep = ResetStep::WAIT_NVM;
+  _resetResult = Status::Error(Err::IN_PROGRESS, "Reset started");
+  return _resetResult;
+}
+
+Status BME280::beginRecover() {
+  if (!_initialized) {
+    return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
+  }
+  if (_resetStep != ResetStep::IDLE) {
+    return Status::Error(Err::BUSY, "Reset in progress");
+  }
+
+  uint8_t chipId = 0;
+  Status st = readRegister(cmd::REG_CHIP_ID, chipId);
+  if (!st.ok()) {
+    return st;
+  }
+  if (chipId != cmd::CHIP_ID_BME280) {
+    return Status::Error(Err::CHIP_ID_MISMATCH, "Chip ID mismatch", chipId);
+  }
+
+  return beginReset();
+}
+
+Status BME280::_writeReset() {
+  _measurementRequested = false;
+  _triggerPending = false;
+  _measurementReady = false;
+  _measurementStartMs = 0;
+  _measurementStartUs = 0;
+
+  // Registers return to reset defaults regardless of whether the write is ACKed
+  _shadowValid = false;
+  return writeRegister(cmd::REG_RESET, cmd::RESET_VALUE);
+}
+
+void BME280::_tickReset(uint32_t nowMs) {
+  Status st = Status::Ok();
+
+  switch (_resetStep) {
+    case ResetStep::WAIT_NVM: {
+      if (!deadlineReached(nowMs, _resetNextPollMs)) {
+        return;
+      }
+      uint8_t status = 0;
+      // Soft reset clears spi3w_en
+      st = _enableSpi3wRaw();
+      if (st.ok()) {
+        st = readRegister(cmd::REG_STATUS, status);
+      }
+      if (!st.ok()) {
+        break;
+      }
+      if ((status & cmd::MASK_STATUS_IM_UPDATE) == 0) {
+        _resetStep = ResetStep::LOAD_CALIBRATION;
+        return;
+      }
+      if (deadlineReached(nowMs, _resetDeadlineMs)) {
+        st = Status::Error(Err::TIMEOUT, "Reset timeout");
+        break;
+      }
+      _resetNextPollMs = nowMs + RESET_POLL_INTERVAL_MS;
+      return;
+    }
+
+    case ResetStep::LOAD_CALIBRATION:
+      st = _readCalibration();
+      if (st.ok()) {
+        st = _validateCalibration();
+      }
+      if (st.ok()) {
+        _resetStep = ResetStep::APPLY_CONFIG;
+        return;
+      }
+      break;
+
+    case ResetStep::APPLY_CONFIG:
+      st = _applyConfig();
+      break;
+
+    case ResetStep::IDLE:
+    default:
+      return;
+  }
+
+  _resetStep = ResetStep::IDLE;
+  _resetResult = st;
+}
+
+#if BME280_ENABLE_DIAGNOSTICS
 Status BME280::readChipId(uint8_t& id) {
   if (!_initialized) {
     return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
@@ -662,6 +1278,7 @@ Status BME280::readConfig(uint8_t& value) {
   }
   return readRegister(cmd::REG_CONFIG, value);
 }
+#endif
 
 Status BME280::isMeasuring(bool& measuring) {
   if (!_initialized) {
@@ -678,30 +1295,70 @@ Status BME280::isMeasuring(bool& measuring) {
   return Status::Ok();
 }
 
+uint32_t BME280::nextSampleDueMs() const {
+  if (!_initialized || _config.mode == Mode::SLEEP) {
+    return NO_SAMPLE_DUE_MS;
+  }
+  if (_config.mode == Mode::NORMAL) {
+    return _nextSampleDueMs;
+  }
+  // The last start time is stale once its sample has been read
+  if (!_measurementRequested) {
+    return NO_SAMPLE_DUE_MS;
+  }
+  return _measurementStartMs + estimateMeasurementTimeMs();
+}
+
+uint32_t BME280::_normalPeriodMs() const {
+  const uint32_t standbyMs = standbyToMs(_config.standby);
+  return estimateMeasurementTimeMs() + standbyMs + (standbyMs >> STANDBY_SLACK_SHIFT);
+}
+
 uint32_t BME280::estimateMeasurementTimeMs() const {
-  const uint8_t t_osrs = osrsMultiplier(_config.osrsT);
-  const uint8_t p_osrs = osrsMultiplier(_config.osrsP);
-  const uint8_t h_osrs = osrsMultiplier(_config.osrsH);
+  const uint32_t timeUs = estimateMeasurementTimeUs(MeasurementTime::MAX) +
+                          _config.measurementMarginUs;
+  return (timeUs + 999U) / 1000U;
+}
 
-  uint32_t timeUs = 1250;
+uint32_t BME280::estimateMeasurementTimeUs(MeasurementTime variant) const {
+  const uint32_t t_osrs = osrsMultiplier(_config.osrsT);
+  const uint32_t p_osrs = osrsMultiplier(_config.osrsP);
+  const uint32_t h_osrs = osrsMultiplier(_config.osrsH);
+
+  // Datasheet 9.1: t = 1 + 2*T + (2*P + 0.5) + (2*H + 0.5) ms typical,
+  //                    1.25 + 2.3*T + (2.3*P + 0.575) + (2.3*H + 0.575) ms max
+  const bool isMax = (variant == MeasurementTime::MAX);
+  const uint32_t baseUs = isMax ? 1250U : 1000U;
+  const uint32_t perSampleUs = isMax ? 2300U : 2000U;
+  const uint32_t setupUs = isMax ? 575U : 500U;
+
+  uint32_t timeUs = baseUs;
   if (t_osrs > 0) {
-    timeUs += 2300U * t_osrs;
+    timeUs += perSampleUs * t_osrs;
   }
   if (p_osrs > 0) {
-    timeUs += 2300U * p_osrs + 575U;
+    timeUs += perSampleUs * p_osrs + setupUs;
   }
   if (h_osrs > 0) {
-    timeUs += 2300U * h_osrs + 575U;
+    timeUs += perSampleUs * h_osrs + setupUs;
   }
-  timeUs += MEASUREMENT_MARGIN_US;
-
-  return (timeUs + 999U) / 1000U;
+  return timeUs;
 }
 
-Status BME280::_i2cWriteReadRaw(const uint8_t* txBuf, size_t txLen,
+Status BME280::_busWriteReadRaw(const uint8_t* txBuf, size_t txLen,
                                 uint8_t* rxBuf, size_t rxLen) {
   if (txBuf == nullptr || txLen == 0 || (rxLen > 0 && rxBuf == nullptr)) {
-    return Status::Error(Err::INVALID_PARAM, "Invalid I2C buffer");
+    return Status::Error(Err::INVALID_PARAM, "Invalid bus buffer");
+  }
+  if (_asyncOp != AsyncOp::NONE) {
+    return Status::Error(Err::BUSY, "Transfer in flight");
+  }
+  if (_config.bus != BusType::I2C) {
+    if (_config.spiWriteRead == nullptr) {
+      return Status::Error(Err::INVALID_CONFIG, "SPI write-read not set");
+    }
+    return _config.spiWriteRead(txBuf, txLen, rxBuf, rxLen, _config.i2cTimeoutMs,
+                                _config.spiUser);
   }
   if (_config.i2cWriteRead == nullptr) {
     return Status::Error(Err::INVALID_CONFIG, "I2C write-read not set");
@@ -710,9 +1367,18 @@ Status BME280::_i2cWriteReadRaw(const uint8_t* txBuf, size_t txLen,
                               _config.i2cTimeoutMs, _config.i2cUser);
 }
 
-Status BME280::_i2cWriteRaw(const uint8_t* buf, size_t len) {
+Status BME280::_busWriteRaw(const uint8_t* buf, size_t len) {
   if (buf == nullptr || len == 0) {
-    return Status::Error(Err::INVALID_PARAM, "Invalid I2C buffer");
+    return Status::Error(Err::INVALID_PARAM, "Invalid bus buffer");
+  }
+  if (_asyncOp != AsyncOp::NONE) {
+    return Status::Error(Err::BUSY, "Transfer in flight");
+  }
+  if (_config.bus != BusType::I2C) {
+    if (_config.spiWrite == nullptr) {
+      return Status::Error(Err::INVALID_CONFIG, "SPI write not set");
+    }
+    return _config.spiWrite(buf, len, _config.i2cTimeoutMs, _config.spiUser);
   }
   if (_config.i2cWrite == nullptr) {
     return Status::Error(Err::INVALID_CONFIG, "I2C write not set");
@@ -721,53 +1387,254 @@ Status BME280::_i2cWriteRaw(const uint8_t* buf, size_t len) {
                           _config.i2cUser);
 }
 
-Status BME280::_i2cWriteReadTracked(const uint8_t* txBuf, size_t txLen,
+Status BME280::_busWriteReadTracked(const uint8_t* txBuf, size_t txLen,
                                     uint8_t* rxBuf, size_t rxLen) {
   if (txBuf == nullptr || txLen == 0 || (rxLen > 0 && rxBuf == nullptr)) {
-    return Status::Error(Err::INVALID_PARAM, "Invalid I2C buffer");
+    return Status::Error(Err::INVALID_PARAM, "Invalid bus buffer");
+  }
+  if (_asyncOp != AsyncOp::NONE) {
+    return Status::Error(Err::BUSY, "Transfer in flight");
   }
 
-  Status st = _i2cWriteReadRaw(txBuf, txLen, rxBuf, rxLen);
+#if BME280_ENABLE_INSTRUMENTATION
+  const uint32_t startUs = _clockUs();
+#endif
+  Status st = _busWriteReadRaw(txBuf, txLen, rxBuf, rxLen);
   if (st.code == Err::INVALID_CONFIG || st.code == Err::INVALID_PARAM) {
     return st;
   }
+#if BME280_ENABLE_INSTRUMENTATION
+  _recordBusOp(_classifyRead(txBuf[0], rxLen), txBuf[0], txLen + rxLen, startUs, st);
+#endif
   return _updateHealth(st);
 }
 
-Status BME280::_i2cWriteTracked(const uint8_t* buf, size_t len) {
+Status BME280::_busWriteTracked(const uint8_t* buf, size_t len) {
   if (buf == nullptr || len == 0) {
-    return Status::Error(Err::INVALID_PARAM, "Invalid I2C buffer");
+    return Status::Error(Err::INVALID_PARAM, "Invalid bus buffer");
+  }
+  if (_asyncOp != AsyncOp::NONE) {
+    return Status::Error(Err::BUSY, "Transfer in flight");
   }
 
-  Status st = _i2cWriteRaw(buf, len);
+#if BME280_ENABLE_INSTRUMENTATION
+  const uint32_t startUs = _clockUs();
+#endif
+  Status st = _busWriteRaw(buf, len);
   if (st.code == Err::INVALID_CONFIG || st.code == Err::INVALID_PARAM) {
     return st;
   }
+#if BME280_ENABLE_INSTRUMENTATION
+  _recordBusOp(_classifyWrite(buf, len), buf[0], len, startUs, st);
+#endif
   return _updateHealth(st);
 }
 
+Status BME280::_i2cSubmitRaw(const uint8_t* txBuf, size_t txLen,
+                             uint8_t* rxBuf, size_t rxLen) {
+  if (txBuf == nullptr || txLen == 0 || (rxLen > 0 && rxBuf == nullptr)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid bus buffer");
+  }
+  if (_config.i2cSubmit == nullptr) {
+    return Status::Error(Err::INVALID_CONFIG, "I2C submit not set");
+  }
+
+  I2cTransfer xfer;
+  xfer.addr = _config.i2cAddress;
+  xfer.txData = txBuf;
+  xfer.txLen = txLen;
+  xfer.rxData = rxBuf;
+  xfer.rxLen = rxLen;
+  xfer.timeoutMs = _config.i2cTimeoutMs;
+
+  _asyncDone.store(false, std::memory_order_relaxed);
+  return _config.i2cSubmit(xfer, _config.i2cUser);
+}
+
+Status BME280::_i2cSubmitTracked(AsyncOp op, const uint8_t* txBuf, size_t txLen,
+                                 uint8_t* rxBuf, size_t rxLen) {
+  if (_asyncOp != AsyncOp::NONE) {
+    return Status::Error(Err::BUSY, "Transfer in flight");
+  }
+
+  _asyncOp = op;
+#if BME280_ENABLE_INSTRUMENTATION
+  if (txBuf != nullptr && txLen > 0) {
+    _asyncBusOp = (rxLen > 0) ? _classifyRead(txBuf[0], rxLen) : _classifyWrite(txBuf, txLen);
+    _asyncBusReg = txBuf[0];
+  }
+  _asyncBusBytes = txLen + rxLen;
+  _asyncStartUs = _clockUs();
+#endif
+  Status st = _i2cSubmitRaw(txBuf, txLen, rxBuf, rxLen);
+  if (st.code == Err::IN_PROGRESS) {
+    return st;
+  }
+  if (st.ok()) {
+    // Completed synchronously; account for it on the next tick() like any completion
+    onTransferComplete(st);
+    return Status::Error(Err::IN_PROGRESS, "Transfer completed");
+  }
+
+  _asyncOp = AsyncOp::NONE;
+  if (st.code == Err::INVALID_CONFIG || st.code == Err::INVALID_PARAM) {
+    return st;
+  }
+#if BME280_ENABLE_INSTRUMENTATION
+  _recordBusOp(_asyncBusOp, _asyncBusReg, _asyncBusBytes, _asyncStartUs, st);
+#endif
+  return _updateHealth(st);
+}
+
+Status BME280::_i2cCompleteTracked(const Status& result) {
+#if BME280_ENABLE_INSTRUMENTATION
+  // Latency includes the time until tick() observed the completion
+  _recordBusOp(_asyncBusOp, _asyncBusReg, _asyncBusBytes, _asyncStartUs, result);
+#endif
+  return _updateHealth(result);
+}
+
+#if BME280_ENABLE_INSTRUMENTATION
+BusOp BME280::_classifyRead(uint8_t reg, size_t rxLen) const {
+  // SPI read addresses already carry bit 7; normalize so both buses classify alike
+  reg = static_cast<uint8_t>(reg | 0x80);
+  if (reg == cmd::REG_STATUS) {
+    return (rxLen == cmd::FUSED_LEN) ? BusOp::FUSED_READ
+         : (rxLen == 1)              ? BusOp::STATUS_POLL
+                                     : BusOp::REGISTER_READ;
+  }
+  if (reg >= cmd::REG_DATA_START) {
+    return BusOp::DATA_READ;
+  }
+  if ((reg >= cmd::REG_CALIB_TP_START && reg <= cmd::REG_CALIB_H1) ||
+      (reg >= cmd::REG_CALIB_H_START &&
+       reg < cmd::REG_CALIB_H_START + cmd::REG_CALIB_H_LEN)) {
+    return BusOp::CALIBRATION_READ;
+  }
+  return BusOp::REGISTER_READ;
+}
+
+BusOp BME280::_classifyWrite(const uint8_t* buf, size_t len) const {
+  BusOp op = BusOp::CONFIG_WRITE;
+  for (size_t i = 0; i + 1 < len; i += 2) {
+    const uint8_t reg = static_cast<uint8_t>(buf[i] | 0x80);
+    const uint8_t value = buf[i + 1];
+    if (reg == cmd::REG_RESET && value == cmd::RESET_VALUE) {
+      return BusOp::RESET;
+    }
+    // Mode bits 01 and 10 both select FORCED
+    const uint8_t mode = value & 0x03;
+    if (reg == cmd::REG_CTRL_MEAS && (mode == 0x01 || mode == 0x02)) {
+      op = BusOp::TRIGGER;
+    }
+  }
+  return op;
+}
+
+void BME280::_recordBusOp(BusOp op, uint8_t reg, size_t bytes, uint32_t startUs,
+                          const Status& st) {
+  const uint32_t latencyUs = _clockUs() - startUs;
+  const uint32_t maxU32 = UINT32_MAX;
+
+  BusOpStats& stats = _busStats.ops[static_cast<size_t>(op)];
+  stats.count++;
+  if (!st.ok()) {
+    stats.failures++;
+  }
+  stats.bytes += static_cast<uint32_t>(bytes);
+  stats.totalUs = (maxU32 - stats.totalUs < latencyUs) ? maxU32 : stats.totalUs + latencyUs;
+  if (latencyUs > stats.maxUs) {
+    stats.maxUs = latencyUs;
+  }
+  _busStats.latencyHistogram[latencyBucket(latencyUs)]++;
+
+  BusTraceEntry& entry = _trace[_traceCount % BME280_TRACE_DEPTH];
+  entry.startUs = startUs;
+  entry.latencyUs = latencyUs;
+  entry.reg = reg;
+  entry.len = static_cast<uint8_t>((bytes > 255) ? 255 : bytes);
+  entry.op = op;
+  entry.code = st.code;
+  _traceCount++;
+}
+
+void BME280::resetBusStats() {
+  _busStats = BusStats{};
+  _traceCount = 0;
+}
+
+size_t BME280::busTrace(BusTraceEntry* out, size_t maxEntries) const {
+  if (out == nullptr) {
+    return 0;
+  }
+  size_t available = (_traceCount < BME280_TRACE_DEPTH) ? _traceCount : BME280_TRACE_DEPTH;
+  if (available > maxEntries) {
+    available = maxEntries;
+  }
+  // Oldest of the requested window first
+  const uint32_t first = _traceCount - static_cast<uint32_t>(available);
+  for (size_t i = 0; i < available; ++i) {
+    out[i] = _trace[(first + i) % BME280_TRACE_DEPTH];
+  }
+  return available;
+}
+#endif
+
+bool BME280::_asyncPollComplete(Status& result) {
+  if (_asyncDone.load(std::memory_order_acquire)) {
+    result = _asyncResult;
+    return true;
+  }
+  if (_config.i2cPoll != nullptr) {
+    const Status st = _config.i2cPoll(_config.i2cUser);
+    if (st.code != Err::IN_PROGRESS) {
+      result = st;
+      return true;
+    }
+  }
+  return false;
+}
+
 Status BME280::readRegs(uint8_t startReg, uint8_t* buf, size_t len) {
   if (buf == nullptr || len == 0) {
     return Status::Error(Err::INVALID_PARAM, "Invalid read buffer");
   }
 
-  uint8_t reg = startReg;
-  return _i2cWriteReadTracked(&reg, 1, buf, len);
+  uint8_t reg = _readAddress(startReg);
+  return _busWriteReadTracked(&reg, 1, buf, len);
 }
 
 Status BME280::writeRegs(uint8_t startReg, const uint8_t* buf, size_t len) {
   if (buf == nullptr || len == 0) {
     return Status::Error(Err::INVALID_PARAM, "Invalid write buffer");
   }
-  if (len > MAX_WRITE_LEN) {
+  if (len > MAX_WRITE_PAIRS) {
     return Status::Error(Err::INVALID_PARAM, "Write length too large");
   }
 
-  uint8_t payload[MAX_WRITE_LEN + 1] = {};
-  payload[0] = startReg;
-  std::memcpy(&payload[1], buf, len);
+  RegPair pairs[MAX_WRITE_PAIRS];
+  for (size_t i = 0; i < len; ++i) {
+    pairs[i].reg = static_cast<uint8_t>(startReg + i);
+    pairs[i].value = buf[i];
+  }
+  return writeRegPairs(pairs, len);
+}
+
+Status BME280::writeRegPairs(const RegPair* pairs, size_t count) {
+  if (pairs == nullptr || count == 0) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid write pairs");
+  }
+  if (count > MAX_WRITE_PAIRS) {
+    return Status::Error(Err::INVALID_PARAM, "Too many write pairs");
+  }
+
+  uint8_t payload[MAX_WRITE_PAIRS * 2] = {};
+  for (size_t i = 0; i < count; ++i) {
+    payload[2 * i] = _writeAddress(pairs[i].reg);
+    payload[2 * i + 1] = pairs[i].value;
+  }
 
-  return _i2cWriteTracked(payload, len + 1);
+  return _busWriteTracked(payload, count * 2);
 }
 
 Status BME280::readRegister(uint8_t reg, uint8_t& value) {
@@ -779,8 +1646,59 @@ Status BME280::writeRegister(uint8_t reg, uint8_t value) {
 }
 
 Status BME280::_readRegisterRaw(uint8_t reg, uint8_t& value) {
-  uint8_t addr = reg;
-  return _i2cWriteReadRaw(&addr, 1, &value, 1);
+  uint8_t addr = _readAddress(reg);
+  return _busWriteReadRaw(&addr, 1, &value, 1);
+}
+
+Status BME280::_enableSpi3wRaw() {
+  if (_config.bus != BusType::SPI_3WIRE) {
+    return Status::Ok();
+  }
+  // Full config value: a bare spi3w_en byte would also clear t_sb and filter
+  const uint8_t payload[2] = {_writeAddress(cmd::REG_CONFIG),
+                              buildConfig(_config.standby, _config.filter, true)};
+  return _busWriteRaw(payload, sizeof(payload));
+}
+
+uint8_t BME280::_readAddress(uint8_t reg) const {
+  return (_config.bus == BusType::I2C) ? reg : static_cast<uint8_t>(reg | cmd::SPI_READ_BIT);
+}
+
+uint8_t BME280::_writeAddress(uint8_t reg) const {
+  return (_config.bus == BusType::I2C) ? reg : static_cast<uint8_t>(reg & cmd::SPI_WRITE_MASK);
+}
+
+uint32_t BME280::_clockUs() const {
+  if (_config.clockUs != nullptr) {
+    return static_cast<uint32_t>(_config.clockUs(_config.clockUser));
+  }
+  return micros();
+}
+
+uint64_t BME280::_clockUs64() const {
+  if (_config.clockUs != nullptr) {
+    return _config.clockUs(_config.clockUser);
+  }
+  return micros();
+}
+
+uint64_t BME280::_forcedElapsedUs() const {
+  if (_config.clockUs != nullptr) {
+    return _config.clockUs(_config.clockUser) - _measurementStartUs;
+  }
+  // micros() wraps at 32 bits; the modular difference stays exact
+  return static_cast<uint32_t>(micros() - static_cast<uint32_t>(_measurementStartUs));
+}
+
+uint32_t BME280::_clockMs() const {
+  if (_config.clockUs != nullptr) {
+    return static_cast<uint32_t>(_config.clockUs(_config.clockUser) / 1000U);
+  }
+  return millis();
+}
+
+uint32_t BME280::_nowMs() const {
+  return _inTick ? _tickNowMs : _clockMs();
 }
 
 Status BME280::_updateHealth(const Status& st) {
@@ -788,9 +1706,9 @@ Status BME280::_updateHealth(const Status& st) {
     return st;
   }
 
-  const uint32_t now = millis();
-  const uint32_t maxU32 = std::numeric_limits<uint32_t>::max();
-  const uint8_t maxU8 = std::numeric_limits<uint8_t>::max();
+  const uint32_t now = _nowMs();
+  const uint32_t maxU32 = UINT32_MAX;
+  const uint8_t maxU8 = UINT8_MAX;
 
   if (st.ok()) {
     _lastOkMs = now;
@@ -821,56 +1739,127 @@ Status BME280::_updateHealth(const Status& st) {
 }
 
 Status BME280::_applyConfig() {
-  const uint8_t ctrlHum = buildCtrlHum(_config.osrsH);
-  const uint8_t ctrlMeasSleep = buildCtrlMeas(_config.osrsT, _config.osrsP, Mode::SLEEP);
-  const uint8_t ctrlMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, _config.mode);
-  const uint8_t config = buildConfig(_config.standby, _config.filter);
-
-  Status st = writeRegister(cmd::REG_CTRL_MEAS, ctrlMeasSleep);
+  // A triggered FORCED conversion is restarted if any register changes
+  const bool forcedPending = _config.mode == Mode::FORCED && _measurementRequested &&
+                             !_triggerPending && _asyncOp == AsyncOp::NONE;
+  const uint8_t ctrlMeas = forcedPending
+                               ? buildCtrlMeas(_config.osrsT, _config.osrsP, Mode::FORCED)
+                               : settledCtrlMeas(_config.osrsT, _config.osrsP, _config.mode);
+  bool started = false;
+  Status st = _writeSettings(buildCtrlHum(_config.osrsH), ctrlMeas,
+                             buildConfig(_config.standby, _config.filter, _config.bus == BusType::SPI_3WIRE), started);
   if (!st.ok()) {
     return st;
   }
 
-  st = writeRegister(cmd::REG_CONFIG, config);
-  if (!st.ok()) {
-    return st;
+  // Writing ctrl_meas in NORMAL mode (re)starts the cycle with a conversion
+  if (started && _config.mode == Mode::NORMAL) {
+    _nextSampleDueMs = _nowMs() + estimateMeasurementTimeMs();
+  } else if (started) {
+    _measurementStartUs = _clockUs64();
+    _measurementStartMs = _nowMs();
   }
+  return Status::Ok();
+}
 
-  st = writeRegister(cmd::REG_CTRL_HUM, ctrlHum);
-  if (!st.ok()) {
-    return st;
+Status BME280::_applySettings(Oversampling osrsT, Oversampling osrsP, Oversampling osrsH,
+                              Filter filter, Standby standby, Mode mode) {
+  if (_resetStep != ResetStep::IDLE) {
+    return Status::Error(Err::BUSY, "Reset in progress");
   }
 
-  return writeRegister(cmd::REG_CTRL_MEAS, ctrlMeas);
-}
+  const Config previous = _config;
+  _config.osrsT = osrsT;
+  _config.osrsP = osrsP;
+  _config.osrsH = osrsH;
+  _config.filter = filter;
+  _config.standby = standby;
+  _config.mode = mode;
 
-Status BME280::_readCalibration() {
-  uint8_t calibTP[cmd::REG_CALIB_TP_LEN] = {};
-  Status st = readRegs(cmd::REG_CALIB_TP_START, calibTP, sizeof(calibTP));
+  Status st = _applyConfig();
   if (!st.ok()) {
+    _config = previous;
     return st;
   }
 
-  _digT1 = static_cast<uint16_t>((calibTP[1] << 8) | calibTP[0]);
-  _digT2 = static_cast<int16_t>((calibTP[3] << 8) | calibTP[2]);
-  _digT3 = static_cast<int16_t>((calibTP[5] << 8) | calibTP[4]);
+  if (mode == Mode::SLEEP) {
+    _measurementRequested = false;
+  }
+  return Status::Ok();
+}
 
-  _digP1 = static_cast<uint16_t>((calibTP[7] << 8) | calibTP[6]);
-  _digP2 = static_cast<int16_t>((calibTP[9] << 8) | calibTP[8]);
-  _digP3 = static_cast<int16_t>((calibTP[11] << 8) | calibTP[10]);
-  _digP4 = static_cast<int16_t>((calibTP[13] << 8) | calibTP[12]);
-  _digP5 = static_cast<int16_t>((calibTP[15] << 8) | calibTP[14]);
-  _digP6 = static_cast<int16_t>((calibTP[17] << 8) | calibTP[16]);
-  _digP7 = static_cast<int16_t>((calibTP[19] << 8) | calibTP[18]);
-  _digP8 = static_cast<int16_t>((calibTP[21] << 8) | calibTP[20]);
-  _digP9 = static_cast<int16_t>((calibTP[23] << 8) | calibTP[22]);
+Status BME280::_writeSettings(uint8_t ctrlHum, uint8_t ctrlMeas, uint8_t config,
+                              bool& started) {
+  started = false;
+  const uint8_t mode = ctrlMeas & cmd::MASK_CTRL_MEAS_MODE;
+  const bool targetForced = mode == modeToReg(Mode::FORCED);
+  const bool targetNormal = mode == modeToReg(Mode::NORMAL);
+  // The shadow holds the mode the device settles in; FORCED falls back to sleep
+  const uint8_t ctrlMeasSleep =
+      static_cast<uint8_t>(ctrlMeas & static_cast<uint8_t>(~cmd::MASK_CTRL_MEAS_MODE));
+  const uint8_t settled = targetForced ? ctrlMeasSleep : ctrlMeas;
+  const bool needConfig = !_shadowValid || config != _shadowConfig;
+  const bool needHum = !_shadowValid || ctrlHum != _shadowCtrlHum;
+  const bool needMeas = !_shadowValid || settled != _shadowCtrlMeas;
+  const bool runningNormal = _shadowValid &&
+      (_shadowCtrlMeas & cmd::MASK_CTRL_MEAS_MODE) == modeToReg(Mode::NORMAL);
+  // A FORCED conversion in flight is stopped before any register changes and
+  // triggered again afterwards, so it never mixes old and new settings
+  const bool restartForced = targetForced && (needConfig || needHum || needMeas);
+
+  RegPair pairs[4];
+  size_t count = 0;
+  uint8_t deviceMeas = _shadowCtrlMeas;
+  bool deviceMeasKnown = _shadowValid;
+
+  // config writes are only guaranteed to take effect in sleep mode
+  if ((needConfig && (!deviceMeasKnown || runningNormal)) || restartForced) {
+    pairs[count++] = RegPair{cmd::REG_CTRL_MEAS, ctrlMeasSleep};
+    deviceMeas = ctrlMeasSleep;
+    deviceMeasKnown = true;
+  }
+  if (needConfig) {
+    pairs[count++] = RegPair{cmd::REG_CONFIG, config};
+  }
+  if (needHum) {
+    pairs[count++] = RegPair{cmd::REG_CTRL_HUM, ctrlHum};
+  }
+
+  // ctrl_hum only takes effect on the next ctrl_meas write; in FORCED/SLEEP
+  // the next trigger provides it, in NORMAL it has to be written now
+  if (restartForced) {
+    pairs[count++] = RegPair{cmd::REG_CTRL_MEAS, ctrlMeas};
+    started = true;
+  } else if (!deviceMeasKnown || deviceMeas != settled || (needHum && targetNormal)) {
+    pairs[count++] = RegPair{cmd::REG_CTRL_MEAS, settled};
+    started = targetNormal;
+  }
+
+  if (count > 0) {
+    // One START/STOP for the whole sequence; the device applies pairs in order
+    const Status st = writeRegPairs(pairs, count);
+    if (!st.ok()) {
+      // A failed transaction leaves the device state unknown
+      _shadowValid = false;
+      started = false;
+      return st;
+    }
+  }
 
-  uint8_t h1 = 0;
-  st = readRegs(cmd::REG_CALIB_H1, &h1, 1);
+  _shadowCtrlHum = ctrlHum;
+  _shadowCtrlMeas = settled;
+  _shadowConfig = config;
+  _shadowValid = true;
+  return Status::Ok();
+}
+
+Status BME280::_readCalibration() {
+  // 0x88..0xA1 includes H1, so two bursts cover the whole calibration set
+  uint8_t calibTP[cmd::REG_CALIB_TP_LEN] = {};
+  Status st = readRegs(cmd::REG_CALIB_TP_START, calibTP, sizeof(calibTP));
   if (!st.ok()) {
     return st;
   }
-  _digH1 = h1;
 
   uint8_t calibH[cmd::REG_CALIB_H_LEN] = {};
   st = readRegs(cmd::REG_CALIB_H_START, calibH, sizeof(calibH));
@@ -878,23 +1867,69 @@ Status BME280::_readCalibration() {
     return st;
   }
 
-  _digH2 = static_cast<int16_t>((calibH[1] << 8) | calibH[0]);
-  _digH3 = calibH[2];
+  _parseCalibration(calibTP, calibTP[cmd::CALIB_TP_IDX_H1], calibH);
+  return Status::Ok();
+}
 
-  int16_t h4 = static_cast<int16_t>((calibH[3] << 4) | (calibH[4] & 0x0F));
-  int16_t h5 = static_cast<int16_t>((calibH[5] << 4) | (calibH[4] >> 4));
-  _digH4 = signExtend12(h4);
-  _digH5 = signExtend12(h5);
-  _digH6 = static_cast<int8_t>(calibH[6]);
+Status BME280::_loadCalibrationBlob(const CalibrationBlob& blob) {
+  const uint8_t* d = blob.data;
+  if (d[BLOB_IDX_VERSION] != BLOB_VERSION) {
+    return Status::Error(Err::CALIBRATION_INVALID, "Unsupported calibration blob",
+                         d[BLOB_IDX_VERSION]);
+  }
+  const uint16_t storedCrc = static_cast<uint16_t>(d[BLOB_IDX_CRC] |
+                                                   (d[BLOB_IDX_CRC + 1] << 8));
+  if (crc16Ccitt(d, BLOB_IDX_CRC) != storedCrc) {
+    return Status::Error(Err::CALIBRATION_INVALID, "Calibration blob CRC mismatch");
+  }
+
+  if (_config.calibSpotCheck) {
+    uint8_t t1[2] = {};
+    Status st = readRegs(cmd::REG_DIG_T1_LSB, t1, sizeof(t1));
+    if (!st.ok()) {
+      return st;
+    }
+    if (t1[0] != d[BLOB_IDX_TP] || t1[1] != d[BLOB_IDX_TP + 1]) {
+      return Status::Error(Err::CALIBRATION_INVALID, "Calibration blob does not match device",
+                           static_cast<int32_t>((t1[1] << 8) | t1[0]));
+    }
+  }
 
+  _parseCalibration(&d[BLOB_IDX_TP], d[BLOB_IDX_H1], &d[BLOB_IDX_H]);
   return Status::Ok();
 }
 
+void BME280::_parseCalibration(const uint8_t* calibTP, uint8_t h1, const uint8_t* calibH) {
+  _calib.digT1 = static_cast<uint16_t>((calibTP[1] << 8) | calibTP[0]);
+  _calib.digT2 = static_cast<int16_t>((calibTP[3] << 8) | calibTP[2]);
+  _calib.digT3 = static_cast<int16_t>((calibTP[5] << 8) | calibTP[4]);
+
+  _calib.digP1 = static_cast<uint16_t>((calibTP[7] << 8) | calibTP[6]);
+  _calib.digP2 = static_cast<int16_t>((calibTP[9] << 8) | calibTP[8]);
+  _calib.digP3 = static_cast<int16_t>((calibTP[11] << 8) | calibTP[10]);
+  _calib.digP4 = static_cast<int16_t>((calibTP[13] << 8) | calibTP[12]);
+  _calib.digP5 = static_cast<int16_t>((calibTP[15] << 8) | calibTP[14]);
+  _calib.digP6 = static_cast<int16_t>((calibTP[17] << 8) | calibTP[16]);
+  _calib.digP7 = static_cast<int16_t>((calibTP[19] << 8) | calibTP[18]);
+  _calib.digP8 = static_cast<int16_t>((calibTP[21] << 8) | calibTP[20]);
+  _calib.digP9 = static_cast<int16_t>((calibTP[23] << 8) | calibTP[22]);
+
+  _calib.digH1 = h1;
+  _calib.digH2 = static_cast<int16_t>((calibH[1] << 8) | calibH[0]);
+  _calib.digH3 = calibH[2];
+
+  int16_t h4 = static_cast<int16_t>((calibH[3] << 4) | (calibH[4] & 0x0F));
+  int16_t h5 = static_cast<int16_t>((calibH[5] << 4) | (calibH[4] >> 4));
+  _calib.digH4 = signExtend12(h4);
+  _calib.digH5 = signExtend12(h5);
+  _calib.digH6 = static_cast<int8_t>(calibH[6]);
+}
+
 Status BME280::_validateCalibration() {
-  if (_digT1 == 0 || _digT1 == 0xFFFF) {
+  if (_calib.digT1 == 0 || _calib.digT1 == 0xFFFF) {
     return Status::Error(Err::CALIBRATION_INVALID, "Invalid temperature calibration");
   }
-  if (_digP1 == 0 || _digP1 == 0xFFFF) {
+  if (_calib.digP1 == 0 || _calib.digP1 == 0xFFFF) {
     return Status::Error(Err::CALIBRATION_INVALID, "Invalid pressure calibration");
   }
 
@@ -902,83 +1937,109 @@ Status BME280::_validateCalibration() {
 }
 
 Status BME280::_readRawData() {
-  uint8_t data[cmd::DATA_LEN] = {};
-  Status st = readRegs(cmd::REG_DATA_START, data, sizeof(data));
+  // In capture mode the burst lands directly in the next frame slot
+  uint8_t local[cmd::DATA_LEN] = {};
+  uint8_t* slot = _captureSlot();
+  uint8_t* data = (slot != nullptr) ? slot : local;
+
+  // Read only the enabled channels: press 0xF7..0xF9, temp 0xFA..0xFC, hum 0xFD..0xFE.
+  // Skipped channels keep the device's skip pattern so frames decode the same way.
+  const Channels ch = channels();
+  const size_t first = hasPressure(ch) ? cmd::DATA_IDX_PRESS : cmd::DATA_IDX_TEMP;
+  const size_t end = hasHumidity(ch) ? cmd::DATA_LEN : cmd::DATA_IDX_HUM;
+  if (!hasPressure(ch)) {
+    data[cmd::DATA_IDX_PRESS] = cmd::SKIP_MSB;
+    data[cmd::DATA_IDX_PRESS + 1] = 0;
+    data[cmd::DATA_IDX_PRESS + 2] = 0;
+  }
+  if (!hasHumidity(ch)) {
+    data[cmd::DATA_IDX_HUM] = cmd::SKIP_MSB;
+    data[cmd::DATA_IDX_HUM + 1] = 0;
+  }
+  Status st = readRegs(static_cast<uint8_t>(cmd::REG_DATA_START + first), &data[first],
+                       end - first);
   if (!st.ok()) {
     return st;
   }
 
-  _rawSample.adcP = (static_cast<int32_t>(data[0]) << 12) |
-                    (static_cast<int32_t>(data[1]) << 4) |
-                    (static_cast<int32_t>(data[2]) >> 4);
-  _rawSample.adcT = (static_cast<int32_t>(data[3]) << 12) |
-                    (static_cast<int32_t>(data[4]) << 4) |
-                    (static_cast<int32_t>(data[5]) >> 4);
-  _rawSample.adcH = (static_cast<int32_t>(data[6]) << 8) |
-                    static_cast<int32_t>(data[7]);
-
+  if (slot == nullptr) {
+    _decodeRawData(data);
+  }
   return Status::Ok();
 }
 
-Status BME280::_compensate() {
-  const int32_t adcT = _rawSample.adcT;
-  const int32_t adcP = _rawSample.adcP;
-  const int32_t adcH = _rawSample.adcH;
-
-  int32_t var1 = (((adcT >> 3) - (static_cast<int32_t>(_digT1) << 1)) *
-                  static_cast<int32_t>(_digT2)) >> 11;
-  int32_t var2 = (((((adcT >> 4) - static_cast<int32_t>(_digT1)) *
-                    ((adcT >> 4) - static_cast<int32_t>(_digT1))) >> 12) *
-                  static_cast<int32_t>(_digT3)) >> 14;
-
-  _tFine = var1 + var2;
-  _compSample.tempC_x100 = (_tFine * 5 + 128) >> 8;
-
-  int64_t pVar1 = static_cast<int64_t>(_tFine) - 128000;
-  int64_t pVar2 = pVar1 * pVar1 * static_cast<int64_t>(_digP6);
-  pVar2 = pVar2 + ((pVar1 * static_cast<int64_t>(_digP5)) << 17);
-  pVar2 = pVar2 + (static_cast<int64_t>(_digP4) << 35);
-  pVar1 = ((pVar1 * pVar1 * static_cast<int64_t>(_digP3)) >> 8) +
-          ((pVar1 * static_cast<int64_t>(_digP2)) << 12);
-  pVar1 = (((static_cast<int64_t>(1) << 47) + pVar1) *
-           static_cast<int64_t>(_digP1)) >> 33;
-  if (pVar1 == 0) {
-    return Status::Error(Err::COMPENSATION_ERROR, "Pressure div by zero");
-  }
-
-  int64_t p = 1048576 - static_cast<int64_t>(adcP);
-  p = (((p << 31) - pVar2) * 3125) / pVar1;
-  pVar1 = (static_cast<int64_t>(_digP9) * (p >> 13) * (p >> 13)) >> 25;
-  pVar2 = (static_cast<int64_t>(_digP8) * p) >> 19;
-  p = ((p + pVar1 + pVar2) >> 8) + (static_cast<int64_t>(_digP7) << 4);
-  int64_t pressurePa = p >> 8;
-  if (pressurePa < 0) {
-    pressurePa = 0;
-  } else if (pressurePa > static_cast<int64_t>(std::numeric_limits<uint32_t>::max())) {
-    pressurePa = static_cast<int64_t>(std::numeric_limits<uint32_t>::max());
-  }
-  _compSample.pressurePa = static_cast<uint32_t>(pressurePa);
-
-  int64_t h = static_cast<int64_t>(_tFine) - 76800;
-  const int64_t hTerm1 = (static_cast<int64_t>(adcH) << 14) -
-                         (static_cast<int64_t>(_digH4) << 20) -
-                         (static_cast<int64_t>(_digH5) * h) + 16384;
-  int64_t hTerm2 = ((((h * static_cast<int64_t>(_digH6)) >> 10) *
-                     (((h * static_cast<int64_t>(_digH3)) >> 11) + 32768)) >> 10) +
-                   2097152;
-  hTerm2 = ((hTerm2 * static_cast<int64_t>(_digH2)) + 8192) >> 14;
-  h = (hTerm1 >> 15) * hTerm2;
-  h = h - (((((h >> 15) * (h >> 15)) >> 7) *
-            static_cast<int64_t>(_digH1)) >> 4);
-  if (h < 0) {
-    h = 0;
-  }
-  if (h > HUMIDITY_MAX_X4096) {
-    h = HUMIDITY_MAX_X4096;
-  }
-  _compSample.humidityPct_x1024 = static_cast<uint32_t>(h >> 12);
+Status BME280::_readFused(bool& busy) {
+  uint8_t buf[cmd::FUSED_LEN] = {};
+  Status st = readRegs(cmd::REG_FUSED_START, buf, sizeof(buf));
+  if (!st.ok()) {
+    return st;
+  }
 
+  return _processFused(buf, busy);
+}
+
+Status BME280::_processFused(const uint8_t* buf, bool& busy) {
+  // NORMAL mode reads on schedule and may overlap the next conversion (see tick())
+  const uint8_t status = buf[cmd::FUSED_IDX_STATUS];
+  uint8_t busyMask = cmd::MASK_STATUS_IM_UPDATE;
+  if (_config.mode != Mode::NORMAL) {
+    busyMask |= cmd::MASK_STATUS_MEASURING;
+  }
+  busy = (status & busyMask) != 0;
+  if (busy) {
+    return Status::Ok();
+  }
+
+  // FORCED conversions drop the mode bits back to SLEEP, so only compare them in NORMAL
+  uint8_t measMask = cmd::MASK_CTRL_MEAS_OSRS_T | cmd::MASK_CTRL_MEAS_OSRS_P;
+  if (_config.mode == Mode::NORMAL) {
+    measMask |= cmd::MASK_CTRL_MEAS_MODE;
+  }
+  const uint8_t configMask = cmd::MASK_CONFIG_T_SB | cmd::MASK_CONFIG_FILTER |
+                             cmd::MASK_CONFIG_SPI3W_EN;
+  const uint8_t expectedMeas = buildCtrlMeas(_config.osrsT, _config.osrsP, _config.mode);
+  const uint8_t expectedConfig = buildConfig(_config.standby, _config.filter, _config.bus == BusType::SPI_3WIRE);
+  if (((buf[cmd::FUSED_IDX_CTRL_MEAS] ^ expectedMeas) & measMask) != 0 ||
+      ((buf[cmd::FUSED_IDX_CONFIG] ^ expectedConfig) & configMask) != 0) {
+    if (_configDriftCount < UINT32_MAX) {
+      _configDriftCount++;
+    }
+    // Data was produced with foreign settings; discard it and keep waiting
+    busy = true;
+    return _recoverConfigDrift();
+  }
+
+  uint8_t* slot = _captureSlot();
+  if (slot != nullptr) {
+    std::memcpy(slot, &buf[cmd::FUSED_IDX_DATA], cmd::DATA_LEN);
+  } else {
+    _decodeRawData(&buf[cmd::FUSED_IDX_DATA]);
+  }
   return Status::Ok();
 }
 
+Status BME280::_recoverConfigDrift() {
+  // _applyConfig() re-triggers a pending FORCED conversion
+  _shadowValid = false;
+  return _applyConfig();
+}
+
+uint8_t* BME280::_captureSlot() {
+  if (_frames != nullptr) {
+    return _frames[_frameCount].data;
+  }
+  if (_frameRing != nullptr) {
+    return _ringFrame.data;
+  }
+  return nullptr;
+}
+
+void BME280::_decodeRawData(const uint8_t* data) {
+  comp::decodeRaw(data, _rawSample);
+}
+
+Status BME280::_compensate() {
+  return comp::compensate(_calib, _rawSample, _compSample, _tFine, channels());
+}
+
 }  // namespace BME280
@@ -0,0 +1,398 @@
+/// @file Compensation.cpp
+/// @brief Datasheet compensation backends
+
+#include "BME280/Compensation.h"
+
+namespace BME280 {
+namespace comp {
+namespace {
+
+static constexpr int32_t HUMIDITY_MAX_X4096 = 419430400;
+static constexpr size_t BATCH_CHUNK = 32;
+
+/// Integer temperature compensation shared by the integer backends
+static int32_t temperatureFine(const Calibration& c, int32_t adcT) {
+  const int32_t var1 = (((adcT >> 3) - (static_cast<int32_t>(c.digT1) << 1)) *
+                        static_cast<int32_t>(c.digT2)) >> 11;
+  const int32_t var2 = (((((adcT >> 4) - static_cast<int32_t>(c.digT1)) *
+                          ((adcT >> 4) - static_cast<int32_t>(c.digT1))) >> 12) *
+                        static_cast<int32_t>(c.digT3)) >> 14;
+  return var1 + var2;
+}
+
+/// Datasheet 32-bit humidity; the intermediates fit in int32 for all 16-bit inputs
+static uint32_t humidityInt32(const Calibration& c, int32_t tFine, int32_t adcH) {
+  int32_t h = tFine - 76800;
+  const int32_t term1 = ((adcH << 14) - (static_cast<int32_t>(c.digH4) << 20) -
+                         (static_cast<int32_t>(c.digH5) * h) + 16384) >> 15;
+  const int32_t term2 = (((((((h * static_cast<int32_t>(c.digH6)) >> 10) *
+                             (((h * static_cast<int32_t>(c.digH3)) >> 11) + 32768)) >> 10) +
+                           2097152) * static_cast<int32_t>(c.digH2)) + 8192) >> 14;
+  h = term1 * term2;
+  h = h - (((((h >> 15) * (h >> 15)) >> 7) * static_cast<int32_t>(c.digH1)) >> 4);
+  if (h < 0) {
+    h = 0;
+  }
+  if (h > HUMIDITY_MAX_X4096) {
+    h = HUMIDITY_MAX_X4096;
+  }
+  return static_cast<uint32_t>(h >> 12);
+}
+
+/// Datasheet 32-bit pressure; returns false if the divisor is zero
+static bool pressureInt32(const Calibration& c, int32_t tFine, int32_t adcP, uint32_t& outPa) {
+  int32_t var1 = (tFine >> 1) - 64000;
+  int32_t var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * static_cast<int32_t>(c.digP6);
+  var2 = var2 + ((var1 * static_cast<int32_t>(c.digP5)) << 1);
+  var2 = (var2 >> 2) + (static_cast<int32_t>(c.digP4) << 16);
+  var1 = (((static_cast<int32_t>(c.digP3) * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) +
+          ((static_cast<int32_t>(c.digP2) * var1) >> 1)) >> 18;
+  var1 = ((32768 + var1) * static_cast<int32_t>(c.digP1)) >> 15;
+  if (var1 == 0) {
+    outPa = 0;
+    return false;
+  }
+
+  uint32_t p = (static_cast<uint32_t>(1048576 - adcP) -
+                static_cast<uint32_t>(var2 >> 12)) * 3125u;
+  if (p < 0x80000000u) {
+    p = (p << 1) / static_cast<uint32_t>(var1);
+  } else {
+    p = (p / static_cast<uint32_t>(var1)) * 2;
+  }
+  var1 = (static_cast<int32_t>(c.digP9) *
+          static_cast<int32_t>(((p >> 3) * (p >> 3)) >> 13)) >> 12;
+  var2 = (static_cast<int32_t>(p >> 2) * static_cast<int32_t>(c.digP8)) >> 13;
+  outPa = static_cast<uint32_t>(static_cast<int32_t>(p) + ((var1 + var2 + c.digP7) >> 4));
+  return true;
+}
+
+#if BME280_COMPENSATION != BME280_COMPENSATION_FLOAT
+/// Pressure stage of the batch path; returns false if the divisor is zero
+static bool pressureBatch(const PreparedCalibration& k, int32_t tFine, int32_t adcP,
+                          uint32_t& outPa) {
+#if BME280_COMPENSATION == BME280_COMPENSATION_INT32
+  return pressureInt32(k.calib, tFine, adcP, outPa);
+#else
+  int64_t var1 = static_cast<int64_t>(tFine) - 128000;
+  const int64_t sq = var1 * var1;
+  const int64_t var2 = sq * k.p6 + var1 * k.p5s17 + k.p4s35;
+  var1 = ((sq * k.p3) >> 8) + var1 * k.p2s12;
+  var1 = (((static_cast<int64_t>(1) << 47) + var1) * k.p1) >> 33;
+  if (var1 == 0) {
+    outPa = 0;
+    return false;
+  }
+  int64_t p = 1048576 - static_cast<int64_t>(adcP);
+  p = (((p << 31) - var2) * 3125) / var1;
+  const int64_t p13 = p >> 13;
+  p = ((p + ((k.p9 * p13 * p13) >> 25) + ((k.p8 * p) >> 19)) >> 8) + k.p7s4;
+  int64_t pa = p >> 8;
+  if (pa < 0) {
+    pa = 0;
+  } else if (pa > static_cast<int64_t>(UINT32_MAX)) {
+    pa = static_cast<int64_t>(UINT32_MAX);
+  }
+  outPa = static_cast<uint32_t>(pa);
+  return true;
+#endif
+}
+#endif
+
+} // namespace
+
+Status compensate(const Calibration& calib, const RawSample& raw,
+                  CompensatedSample& out, int32_t& tFine, Channels channels) {
+#if BME280_COMPENSATION == BME280_COMPENSATION_INT32
+  return compensateInt32(calib, raw, out, tFine, channels);
+#elif BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+  return compensateFloat(calib, raw, out, tFine, channels);
+#else
+  return compensateInt64(calib, raw, out, tFine, channels);
+#endif
+}
+
+Status compensateInt64(const Calibration& c, const RawSample& raw,
+                       CompensatedSample& out, int32_t& tFine, Channels channels) {
+  tFine = temperatureFine(c, raw.adcT);
+  out.tempC_x100 = (tFine * 5 + 128) >> 8;
+  out.pressurePa = 0;
+  out.humidityPct_x1024 = 0;
+
+  if (hasPressure(channels)) {
+    int64_t pVar1 = static_cast<int64_t>(tFine) - 128000;
+    int64_t pVar2 = pVar1 * pVar1 * static_cast<int64_t>(c.digP6);
+    pVar2 = pVar2 + ((pVar1 * static_cast<int64_t>(c.digP5)) << 17);
+    pVar2 = pVar2 + (static_cast<int64_t>(c.digP4) << 35);
+    pVar1 = ((pVar1 * pVar1 * static_cast<int64_t>(c.digP3)) >> 8) +
+            ((pVar1 * static_cast<int64_t>(c.digP2)) << 12);
+    pVar1 = (((static_cast<int64_t>(1) << 47) + pVar1) *
+             static_cast<int64_t>(c.digP1)) >> 33;
+    if (pVar1 == 0) {
+      return Status::Error(Err::COMPENSATION_ERROR, "Pressure div by zero");
+    }
+
+    int64_t p = 1048576 - static_cast<int64_t>(raw.adcP);
+    p = (((p << 31) - pVar2) * 3125) / pVar1;
+    pVar1 = (static_cast<int64_t>(c.digP9) * (p >> 13) * (p >> 13)) >> 25;
+    pVar2 = (static_cast<int64_t>(c.digP8) * p) >> 19;
+    p = ((p + pVar1 + pVar2) >> 8) + (static_cast<int64_t>(c.digP7) << 4);
+    int64_t pressurePa = p >> 8;
+    if (pressurePa < 0) {
+      pressurePa = 0;
+    } else if (pressurePa > static_cast<int64_t>(UINT32_MAX)) {
+      pressurePa = static_cast<int64_t>(UINT32_MAX);
+    }
+    out.pressurePa = static_cast<uint32_t>(pressurePa);
+  }
+
+  if (hasHumidity(channels)) {
+    // Same formula as the datasheet 32-bit version, evaluated in int64 for headroom
+    int64_t h = static_cast<int64_t>(tFine) - 76800;
+    const int64_t hTerm1 = (static_cast<int64_t>(raw.adcH) << 14) -
+                           (static_cast<int64_t>(c.digH4) << 20) -
+                           (static_cast<int64_t>(c.digH5) * h) + 16384;
+    int64_t hTerm2 = ((((h * static_cast<int64_t>(c.digH6)) >> 10) *
+                       (((h * static_cast<int64_t>(c.digH3)) >> 11) + 32768)) >> 10) +
+                     2097152;
+    hTerm2 = ((hTerm2 * static_cast<int64_t>(c.digH2)) + 8192) >> 14;
+    h = (hTerm1 >> 15) * hTerm2;
+    h = h - (((((h >> 15) * (h >> 15)) >> 7) *
+              static_cast<int64_t>(c.digH1)) >> 4);
+    if (h < 0) {
+      h = 0;
+    }
+    if (h > HUMIDITY_MAX_X4096) {
+      h = HUMIDITY_MAX_X4096;
+    }
+    out.humidityPct_x1024 = static_cast<uint32_t>(h >> 12);
+  }
+
+  return Status::Ok();
+}
+
+Status compensateInt32(const Calibration& c, const RawSample& raw,
+                       CompensatedSample& out, int32_t& tFine, Channels channels) {
+  tFine = temperatureFine(c, raw.adcT);
+  out.tempC_x100 = (tFine * 5 + 128) >> 8;
+  out.pressurePa = 0;
+  out.humidityPct_x1024 = 0;
+
+  if (hasPressure(channels) && !pressureInt32(c, tFine, raw.adcP, out.pressurePa)) {
+    return Status::Error(Err::COMPENSATION_ERROR, "Pressure div by zero");
+  }
+
+  if (hasHumidity(channels)) {
+    out.humidityPct_x1024 = humidityInt32(c, tFine, raw.adcH);
+  }
+  return Status::Ok();
+}
+
+Status compensateFloat(const Calibration& c, const RawSample& raw,
+                       CompensatedSample& out, int32_t& tFine, Channels channels) {
+  const float adcT = static_cast<float>(raw.adcT);
+  const float t1 = static_cast<float>(c.digT1);
+  float var1 = (adcT / 16384.0f - t1 / 1024.0f) * static_cast<float>(c.digT2);
+  float var2 = adcT / 131072.0f - t1 / 8192.0f;
+  var2 = var2 * var2 * static_cast<float>(c.digT3);
+  const float fine = var1 + var2;
+  tFine = static_cast<int32_t>(fine);
+  out.tempC_x100 = static_cast<int32_t>(fine / 51.2f + (fine >= 0.0f ? 0.5f : -0.5f));
+  out.pressurePa = 0;
+  out.humidityPct_x1024 = 0;
+
+  if (hasPressure(channels)) {
+    var1 = fine / 2.0f - 64000.0f;
+    var2 = var1 * var1 * static_cast<float>(c.digP6) / 32768.0f;
+    var2 = var2 + var1 * static_cast<float>(c.digP5) * 2.0f;
+    var2 = var2 / 4.0f + static_cast<float>(c.digP4) * 65536.0f;
+    var1 = (static_cast<float>(c.digP3) * var1 * var1 / 524288.0f +
+            static_cast<float>(c.digP2) * var1) / 524288.0f;
+    var1 = (1.0f + var1 / 32768.0f) * static_cast<float>(c.digP1);
+    if (var1 == 0.0f) {
+      return Status::Error(Err::COMPENSATION_ERROR, "Pressure div by zero");
+    }
+    float p = 1048576.0f - static_cast<float>(raw.adcP);
+    p = (p - var2 / 4096.0f) * 6250.0f / var1;
+    var1 = static_cast<float>(c.digP9) * p * p / 2147483648.0f;
+    var2 = p * static_cast<float>(c.digP8) / 32768.0f;
+    p = p + (var1 + var2 + static_cast<float>(c.digP7)) / 16.0f;
+    out.pressurePa = (p > 0.0f) ? static_cast<uint32_t>(p) : 0;
+  }
+
+  if (hasHumidity(channels)) {
+    float h = fine - 76800.0f;
+    h = (static_cast<float>(raw.adcH) -
+         (static_cast<float>(c.digH4) * 64.0f + static_cast<float>(c.digH5) / 16384.0f * h)) *
+        (static_cast<float>(c.digH2) / 65536.0f *
+         (1.0f + static_cast<float>(c.digH6) / 67108864.0f * h *
+                     (1.0f + static_cast<float>(c.digH3) / 67108864.0f * h)));
+    h = h * (1.0f - static_cast<float>(c.digH1) * h / 524288.0f);
+    if (h < 0.0f) {
+      h = 0.0f;
+    } else if (h > 100.0f) {
+      h = 100.0f;
+    }
+    out.humidityPct_x1024 = static_cast<uint32_t>(h * 1024.0f);
+  }
+
+  return Status::Ok();
+}
+
+void decodeRaw(const uint8_t* data, RawSample& out) {
+  out.adcP = (static_cast<int32_t>(data[0]) << 12) |
+             (static_cast<int32_t>(data[1]) << 4) |
+             (static_cast<int32_t>(data[2]) >> 4);
+  out.adcT = (static_cast<int32_t>(data[3]) << 12) |
+             (static_cast<int32_t>(data[4]) << 4) |
+             (static_cast<int32_t>(data[5]) >> 4);
+  out.adcH = (static_cast<int32_t>(data[6]) << 8) |
+             static_cast<int32_t>(data[7]);
+}
+
+void prepareCalibration(const Calibration& calib, PreparedCalibration& out) {
+  out.calib = calib;
+  out.t1 = static_cast<int32_t>(calib.digT1);
+  out.t1x2 = static_cast<int32_t>(calib.digT1) << 1;
+  out.t2 = calib.digT2;
+  out.t3 = calib.digT3;
+  out.p1 = calib.digP1;
+  out.p2s12 = static_cast<int64_t>(calib.digP2) * 4096;
+  out.p3 = calib.digP3;
+  out.p4s35 = static_cast<int64_t>(calib.digP4) * (static_cast<int64_t>(1) << 35);
+  out.p5s17 = static_cast<int64_t>(calib.digP5) * 131072;
+  out.p6 = calib.digP6;
+  out.p7s4 = static_cast<int64_t>(calib.digP7) * 16;
+  out.p8 = calib.digP8;
+  out.p9 = calib.digP9;
+  out.h1 = calib.digH1;
+  out.h2 = calib.digH2;
+  out.h3 = calib.digH3;
+  out.h4s20 = static_cast<int32_t>(calib.digH4) * 1048576;
+  out.h5 = calib.digH5;
+  out.h6 = calib.digH6;
+}
+
+Status compensateBatch(const Calibration& calib, const RawSample* in,
+                       CompensatedSample* out, size_t n, Channels channels) {
+  PreparedCalibration prep;
+  prepareCalibration(calib, prep);
+  return compensateBatch(prep, in, out, n, channels);
+}
+
+Status compensateBatch(const PreparedCalibration& k, const RawSample* in,
+                       CompensatedSample* out, size_t n, Channels channels) {
+  if (n > 0 && (in == nullptr || out == nullptr)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid batch buffer");
+  }
+
+  int32_t failures = 0;
+
+#if BME280_COMPENSATION == BME280_COMPENSATION_FLOAT
+  for (size_t i = 0; i < n; ++i) {
+    int32_t tFine = 0;
+    if (!compensateFloat(k.calib, in[i], out[i], tFine, channels).ok()) {
+      out[i].pressurePa = 0;
+      failures++;
+    }
+  }
+#else
+  for (size_t base = 0; base < n; base += BATCH_CHUNK) {
+    const size_t count = (n - base < BATCH_CHUNK) ? (n - base) : BATCH_CHUNK;
+    int32_t adcT[BATCH_CHUNK];
+    int32_t adcP[BATCH_CHUNK];
+    int32_t adcH[BATCH_CHUNK];
+    int32_t fine[BATCH_CHUNK];
+    int32_t tempX100[BATCH_CHUNK];
+    uint32_t pressure[BATCH_CHUNK] = {};
+    uint32_t humidity[BATCH_CHUNK] = {};
+
+    for (size_t i = 0; i < count; ++i) {
+      adcT[i] = in[base + i].adcT;
+      adcP[i] = in[base + i].adcP;
+      adcH[i] = in[base + i].adcH;
+    }
+
+    // Temperature: pure int32, no branches
+    for (size_t i = 0; i < count; ++i) {
+      const int32_t dT = (adcT[i] >> 4) - k.t1;
+      const int32_t var1 = (((adcT[i] >> 3) - k.t1x2) * k.t2) >> 11;
+      const int32_t var2 = (((dT * dT) >> 12) * k.t3) >> 14;
+      fine[i] = var1 + var2;
+      tempX100[i] = (fine[i] * 5 + 128) >> 8;
+    }
+
+    // Pressure: contains a division, kept scalar
+    if (hasPressure(channels)) {
+      for (size_t i = 0; i < count; ++i) {
+        if (!pressureBatch(k, fine[i], adcP[i], pressure[i])) {
+          failures++;
+        }
+      }
+    }
+
+    // Humidity: branch-free clamps
+    if (hasHumidity(channels)) {
+      for (size_t i = 0; i < count; ++i) {
+#if BME280_COMPENSATION == BME280_COMPENSATION_INT32
+        int32_t h = fine[i] - 76800;
+        const int32_t term1 = ((adcH[i] << 14) - k.h4s20 - (k.h5 * h) + 16384) >> 15;
+        const int32_t term2 = (((((((h * k.h6) >> 10) * (((h * k.h3) >> 11) + 32768)) >> 10) +
+                                 2097152) * k.h2) + 8192) >> 14;
+        h = term1 * term2;
+        h = h - (((((h >> 15) * (h >> 15)) >> 7) * k.h1) >> 4);
+#else
+        int64_t h = static_cast<int64_t>(fine[i]) - 76800;
+        const int64_t term1 = (static_cast<int64_t>(adcH[i]) << 14) - k.h4s20 - (k.h5 * h) + 16384;
+        int64_t term2 = ((((h * k.h6) >> 10) * (((h * k.h3) >> 11) + 32768)) >> 10) + 2097152;
+        term2 = ((term2 * k.h2) + 8192) >> 14;
+        h = (term1 >> 15) * term2;
+        h = h - (((((h >> 15) * (h >> 15)) >> 7) * k.h1) >> 4);
+#endif
+        h = (h < 0) ? 0 : h;
+        h = (h > HUMIDITY_MAX_X4096) ? HUMIDITY_MAX_X4096 : h;
+        humidity[i] = static_cast<uint32_t>(h >> 12);
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      out[base + i].tempC_x100 = tempX100[i];
+      out[base + i].pressurePa = pressure[i];
+      out[base + i].humidityPct_x1024 = humidity[i];
+    }
+  }
+#endif
+
+  if (failures > 0) {
+    return Status::Error(Err::COMPENSATION_ERROR, "Pressure div by zero", failures);
+  }
+  return Status::Ok();
+}
+
+Status compensateFrames(const PreparedCalibration& prep, const RawFrame* frames,
+                        CompensatedSample* out, size_t n, Channels channels) {
+  if (n > 0 && (frames == nullptr || out == nullptr)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid batch buffer");
+  }
+
+  int32_t failures = 0;
+  for (size_t base = 0; base < n; base += BATCH_CHUNK) {
+    const size_t count = (n - base < BATCH_CHUNK) ? (n - base) : BATCH_CHUNK;
+    RawSample raw[BATCH_CHUNK];
+    for (size_t i = 0; i < count; ++i) {
+      decodeRaw(frames[base + i].data, raw[i]);
+    }
+    const Status st = compensateBatch(prep, raw, &out[base], count, channels);
+    if (!st.ok()) {
+      failures += st.detail;
+    }
+  }
+
+  if (failures > 0) {
+    return Status::Error(Err::COMPENSATION_ERROR, "Pressure div by zero", failures);
+  }
+  return Status::Ok();
+}
+
+} // namespace comp
+} // namespace BME280
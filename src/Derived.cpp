@@ -0,0 +1,261 @@
+/// @file Derived.cpp
+/// @brief Fixed-point derived quantities
+
+#include "BME280/Derived.h"
+
+namespace BME280 {
+namespace derived {
+namespace {
+
+// Grid parameters; must match scripts/generate_derived_tables.py
+static constexpr uint32_t ALT_RATIO_MIN_Q20 = 262144;     // p/p0 = 0.25
+static constexpr uint32_t ALT_RATIO_SHIFT = 12;
+static constexpr uint32_t ALT_SEGMENTS = 256;
+static constexpr int32_t SLP_ALT_MIN_CM = -51200;
+static constexpr uint32_t SLP_ALT_SHIFT = 12;
+static constexpr uint32_t SLP_SEGMENTS = 256;
+static constexpr int32_t ES_TEMP_MIN_X100 = -6000;
+static constexpr int32_t ES_TEMP_STEP_X100 = 100;
+static constexpr uint32_t ES_SEGMENTS = 148;
+
+static constexpr uint32_t HUMIDITY_FULL_X1024 = 100 * 1024;
+static constexpr int32_t KELVIN_OFFSET_X100 = 27315;
+static constexpr int64_t WATER_GAS_FACTOR = 216679;        // M_w / R = 2.16679e-3 kg K / J, scaled by 1e8
+
+// Generated by scripts/generate_derived_tables.py
+static constexpr int32_t ALTITUDE_CM[257] = {
+  1027776, 1017716, 1007780, 997966, 988270, 978688, 969218, 959857,
+  950602, 941451, 932401, 923449, 914593, 905831, 897161, 888581,
+  880087, 871680, 863356, 855114, 846952, 838868, 830861, 822929,
+  815070, 807283, 799567, 791920, 784341, 776828, 769380, 761996,
+  754675, 747415, 740216, 733076, 725994, 718969, 712000, 705087,
+  698227, 691421, 684667, 677964, 671312, 664710, 658156, 651651,
+  645193, 638781, 632415, 626095, 619818, 613585, 607396, 601248,
+  595142, 589078, 583053, 577069, 571124, 565217, 559349, 553518,
+  547725, 541968, 536246, 530561, 524910, 519294, 513713, 508164,
+  502649, 497167, 491717, 486299, 480912, 475556, 470231, 464937,
+  459672, 454437, 449231, 444053, 438904, 433784, 428691, 423625,
+  418587, 413575, 408590, 403630, 398697, 393789, 388907, 384049,
+  379217, 374408, 369624, 364863, 360126, 355413, 350722, 346055,
+  341410, 336787, 332186, 327607, 323050, 318514, 314000, 309506,
+  305033, 300581, 296149, 291737, 287345, 282973, 278620, 274286,
+  269972, 265677, 261400, 257142, 252903, 248681, 244478, 240292,
+  236124, 231974, 227841, 223726, 219627, 215545, 211480, 207432,
+  203400, 199385, 195385, 191402, 187434, 183482, 179546, 175625,
+  171719, 167829, 163953, 160093, 156247, 152416, 148600, 144798,
+  141010, 137236, 133477, 129731, 126000, 122281, 118577, 114886,
+  111208, 107544, 103893, 100255, 96630, 93017, 89418, 85831,
+  82257, 78695, 75145, 71608, 68083, 64570, 61069, 57580,
+  54102, 50637, 47183, 43740, 40309, 36889, 33481, 30084,
+  26698, 23323, 19959, 16605, 13263, 9931, 6610, 3300,
+  0, -3290, -6569, -9838, -13096, -16345, -19583, -22812,
+  -26030, -29239, -32438, -35627, -38807, -41977, -45137, -48288,
+  -51430, -54562, -57685, -60799, -63903, -66999, -70085, -73163,
+  -76231, -79291, -82342, -85384, -88418, -91442, -94459, -97466,
+  -100466, -103456, -106439, -109413, -112379, -115337, -118286, -121227,
+  -124161, -127086, -130003, -132913, -135814, -138708, -141594, -144472,
+  -147343, -150206, -153061, -155909, -158749, -161582, -164407, -167225,
+  -170036, -172840, -175636, -178425, -181207, -183981, -186749, -189509,
+  -192263,
+};
+
+static constexpr uint32_t SEA_LEVEL_FACTOR_Q24[257] = {
+  15794576, 15870620, 15947100, 16024019, 16101380, 16179186, 16257439, 16336144,
+  16415303, 16494918, 16574994, 16655533, 16736538, 16818012, 16899959, 16982381,
+  17065283, 17148667, 17232536, 17316893, 17401743, 17487088, 17572932, 17659277,
+  17746129, 17833489, 17921361, 18009749, 18098657, 18188087, 18278044, 18368531,
+  18459552, 18551110, 18643210, 18735853, 18829046, 18922790, 19017091, 19111952,
+  19207376, 19303368, 19399932, 19497071, 19594789, 19693091, 19791981, 19891462,
+  19991539, 20092216, 20193496, 20295386, 20397887, 20501005, 20604745, 20709110,
+  20814104, 20919733, 21026001, 21132912, 21240470, 21348680, 21457548, 21567077,
+  21677272, 21788137, 21899679, 22011900, 22124807, 22238404, 22352695, 22467687,
+  22583383, 22699789, 22816910, 22934751, 23053317, 23172613, 23292645, 23413418,
+  23534937, 23657207, 23780234, 23904023, 24028580, 24153910, 24280019, 24406913,
+  24534597, 24663077, 24792358, 24922446, 25053348, 25185070, 25317616, 25450993,
+  25585208, 25720266, 25856173, 25992936, 26130561, 26269054, 26408421, 26548670,
+  26689806, 26831836, 26974766, 27118604, 27263355, 27409027, 27555627, 27703160,
+  27851635, 28001058, 28151436, 28302776, 28455086, 28608372, 28762643, 28917904,
+  29074164, 29231430, 29389709, 29549010, 29709339, 29870705, 30033116, 30196578,
+  30361101, 30526691, 30693358, 30861109, 31029952, 31199896, 31370949, 31543119,
+  31716415, 31890845, 32066419, 32243144, 32421030, 32600085, 32780319, 32961739,
+  33144356, 33328179, 33513216, 33699477, 33886972, 34075710, 34265700, 34456953,
+  34649477, 34843284, 35038381, 35234781, 35432492, 35631525, 35831890, 36033598,
+  36236659, 36441083, 36646882, 36854065, 37062644, 37272629, 37484032, 37696864,
+  37911135, 38126858, 38344044, 38562704, 38782849, 39004492, 39227644, 39452318,
+  39678525, 39906277, 40135587, 40366467, 40598930, 40832988, 41068654, 41305940,
+  41544860, 41785427, 42027653, 42271553, 42517140, 42764426, 43013426, 43264154,
+  43516624, 43770849, 44026844, 44284622, 44544200, 44805590, 45068808, 45333868,
+  45600787, 45869577, 46140256, 46412838, 46687339, 46963775, 47242161, 47522513,
+  47804848, 48089181, 48375530, 48663911, 48954340, 49246834, 49541411, 49838088,
+  50136881, 50437810, 50740891, 51046141, 51353581, 51663226, 51975097, 52289210,
+  52605586, 52924243, 53245201, 53568477, 53894093, 54222067, 54552420, 54885171,
+  55220340, 55557949, 55898017, 56240566, 56585616, 56933189, 57283306, 57635989,
+  57991259, 58349139, 58709651, 59072818, 59438661, 59807204, 60178470, 60552483,
+  60929266, 61308843, 61691237, 62076474, 62464578, 62855573, 63249485, 63646338,
+  64046159,
+};
+
+static constexpr uint32_t SATURATION_MPA[149] = {
+  1901, 2158, 2447, 2771, 3134, 3539, 3992, 4497,
+  5060, 5686, 6382, 7155, 8011, 8960, 10010, 11171,
+  12452, 13865, 15423, 17137, 19021, 21092, 23364, 25855,
+  28584, 31571, 34836, 38403, 42297, 46543, 51169, 56205,
+  61683, 67636, 74102, 81117, 88723, 96964, 105885, 115534,
+  125965, 137232, 149392, 162508, 176645, 191871, 208259, 225886,
+  244833, 265184, 287031, 310468, 335593, 362514, 391339, 422185,
+  455173, 490431, 528093, 568301, 611200, 656946, 705700, 757632,
+  812918, 871743, 934300, 1000793, 1071430, 1146433, 1226030, 1310462,
+  1399976, 1494834, 1595306, 1701672, 1814226, 1933273, 2059129, 2192122,
+  2332596, 2480904, 2637415, 2802511, 2976588, 3160057, 3353343, 3556889,
+  3771149, 3996598, 4233724, 4483033, 4745050, 5020314, 5309386, 5612842,
+  5931279, 6265314, 6615581, 6982737, 7367458, 7770442, 8192406, 8634094,
+  9096266, 9579710, 10085234, 10613672, 11165880, 11742740, 12345158, 12974067,
+  13630424, 14315214, 15029448, 15774163, 16550428, 17359335, 18202007, 19079598,
+  19993287, 20944289, 21933843, 22963224, 24033735, 25146714, 26303529, 27505581,
+  28754305, 30051169, 31397675, 32795361, 34245797, 35750593, 37311389, 38929867,
+  40607743, 42346769, 44148737, 46015477, 47948855, 49950778, 52023192, 54168084,
+  56387477, 58683439, 61058077, 63513540, 66052018,
+};
+
+static_assert(sizeof(ALTITUDE_CM) / sizeof(ALTITUDE_CM[0]) == ALT_SEGMENTS + 1,
+              "Altitude table size mismatch");
+static_assert(sizeof(SEA_LEVEL_FACTOR_Q24) / sizeof(SEA_LEVEL_FACTOR_Q24[0]) == SLP_SEGMENTS + 1,
+              "Sea-level table size mismatch");
+static_assert(sizeof(SATURATION_MPA) / sizeof(SATURATION_MPA[0]) == ES_SEGMENTS + 1,
+              "Saturation table size mismatch");
+
+/// 2^52 / p0, so that (p * reciprocal) >> 32 is p/p0 in Q20
+static uint64_t seaLevelReciprocal(uint32_t seaLevelPa) {
+  return (static_cast<uint64_t>(1) << 52) / seaLevelPa;
+}
+
+static int32_t altitudeFromReciprocal(uint32_t pressurePa, uint64_t reciprocal) {
+  if (pressurePa == 0 || reciprocal == 0) {
+    return 0;
+  }
+  static constexpr uint32_t MAX_OFFSET = (ALT_SEGMENTS << ALT_RATIO_SHIFT) - 1;
+  const uint64_t ratio = (static_cast<uint64_t>(pressurePa) * reciprocal) >> 32;
+  uint32_t offset = 0;
+  if (ratio > ALT_RATIO_MIN_Q20) {
+    const uint64_t above = ratio - ALT_RATIO_MIN_Q20;
+    offset = (above > MAX_OFFSET) ? MAX_OFFSET : static_cast<uint32_t>(above);
+  }
+  const uint32_t idx = offset >> ALT_RATIO_SHIFT;
+  const int32_t frac = static_cast<int32_t>(offset & ((1u << ALT_RATIO_SHIFT) - 1));
+  const int32_t a = ALTITUDE_CM[idx];
+  const int32_t b = ALTITUDE_CM[idx + 1];
+  return a + (((b - a) * frac) >> ALT_RATIO_SHIFT);
+}
+
+} // namespace
+
+int32_t altitudeCm(uint32_t pressurePa, uint32_t seaLevelPa) {
+  if (seaLevelPa == 0) {
+    return 0;
+  }
+  return altitudeFromReciprocal(pressurePa, seaLevelReciprocal(seaLevelPa));
+}
+
+uint32_t seaLevelPressurePa(uint32_t pressurePa, int32_t altitudeCm) {
+  static constexpr int32_t MAX_OFFSET = static_cast<int32_t>(SLP_SEGMENTS << SLP_ALT_SHIFT) - 1;
+  int32_t offset = altitudeCm - SLP_ALT_MIN_CM;
+  if (offset < 0) {
+    offset = 0;
+  } else if (offset > MAX_OFFSET) {
+    offset = MAX_OFFSET;
+  }
+  const uint32_t idx = static_cast<uint32_t>(offset) >> SLP_ALT_SHIFT;
+  const int64_t frac = offset & ((1 << SLP_ALT_SHIFT) - 1);
+  const int64_t a = SEA_LEVEL_FACTOR_Q24[idx];
+  const int64_t b = SEA_LEVEL_FACTOR_Q24[idx + 1];
+  const int64_t factor = a + (((b - a) * frac) >> SLP_ALT_SHIFT);
+  return static_cast<uint32_t>((static_cast<int64_t>(pressurePa) * factor + (1 << 23)) >> 24);
+}
+
+uint32_t saturationVaporPressure_mPa(int32_t tempC_x100) {
+  static constexpr int32_t MAX_OFFSET = static_cast<int32_t>(ES_SEGMENTS) * ES_TEMP_STEP_X100;
+  int32_t offset = tempC_x100 - ES_TEMP_MIN_X100;
+  if (offset < 0) {
+    offset = 0;
+  } else if (offset >= MAX_OFFSET) {
+    return SATURATION_MPA[ES_SEGMENTS];
+  }
+  const uint32_t idx = static_cast<uint32_t>(offset / ES_TEMP_STEP_X100);
+  const uint32_t frac = static_cast<uint32_t>(offset % ES_TEMP_STEP_X100);
+  const uint32_t a = SATURATION_MPA[idx];
+  const uint32_t b = SATURATION_MPA[idx + 1];
+  return a + ((b - a) * frac) / ES_TEMP_STEP_X100;
+}
+
+int32_t dewPointC_x100(int32_t tempC_x100, uint32_t humidityPct_x1024) {
+  if (humidityPct_x1024 > HUMIDITY_FULL_X1024) {
+    humidityPct_x1024 = HUMIDITY_FULL_X1024;
+  }
+  // Actual vapor pressure, then the temperature at which it saturates
+  const uint32_t vapor = static_cast<uint32_t>(
+      (static_cast<uint64_t>(saturationVaporPressure_mPa(tempC_x100)) * humidityPct_x1024) /
+      HUMIDITY_FULL_X1024);
+  if (vapor <= SATURATION_MPA[0]) {
+    return ES_TEMP_MIN_X100;
+  }
+  if (vapor >= SATURATION_MPA[ES_SEGMENTS]) {
+    return ES_TEMP_MIN_X100 + static_cast<int32_t>(ES_SEGMENTS) * ES_TEMP_STEP_X100;
+  }
+
+  uint32_t lo = 0;
+  uint32_t hi = ES_SEGMENTS;
+  while (hi - lo > 1) {
+    const uint32_t mid = (lo + hi) / 2;
+    if (SATURATION_MPA[mid] <= vapor) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  const uint32_t a = SATURATION_MPA[lo];
+  const uint32_t b = SATURATION_MPA[lo + 1];
+  const int32_t frac = static_cast<int32_t>(
+      (static_cast<uint64_t>(vapor - a) * ES_TEMP_STEP_X100 + (b - a) / 2) / (b - a));
+  return ES_TEMP_MIN_X100 + static_cast<int32_t>(lo) * ES_TEMP_STEP_X100 + frac;
+}
+
+uint32_t absoluteHumidity_mgm3(int32_t tempC_x100, uint32_t humidityPct_x1024) {
+  if (humidityPct_x1024 > HUMIDITY_FULL_X1024) {
+    humidityPct_x1024 = HUMIDITY_FULL_X1024;
+  }
+  int32_t kelvinX100 = tempC_x100 + KELVIN_OFFSET_X100;
+  if (kelvinX100 <= 0) {
+    return 0;
+  }
+  const int64_t vapor =
+      (static_cast<int64_t>(saturationVaporPressure_mPa(tempC_x100)) * humidityPct_x1024) /
+      HUMIDITY_FULL_X1024;
+  return static_cast<uint32_t>((vapor * WATER_GAS_FACTOR) /
+                               (static_cast<int64_t>(kelvinX100) * 1000));
+}
+
+void derive(const CompensatedSample& in, DerivedSample& out, const DerivedConfig& config) {
+  out.altitudeCm = altitudeCm(in.pressurePa, config.seaLevelPa);
+  out.seaLevelPa = seaLevelPressurePa(in.pressurePa, config.stationAltitudeCm);
+  out.dewPointC_x100 = dewPointC_x100(in.tempC_x100, in.humidityPct_x1024);
+  out.absHumidity_mgm3 = absoluteHumidity_mgm3(in.tempC_x100, in.humidityPct_x1024);
+}
+
+Status derive(const CompensatedSample* in, DerivedSample* out, size_t n,
+              const DerivedConfig& config) {
+  if (n > 0 && (in == nullptr || out == nullptr)) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid batch buffer");
+  }
+
+  const uint64_t reciprocal = (config.seaLevelPa != 0) ? seaLevelReciprocal(config.seaLevelPa) : 0;
+  for (size_t i = 0; i < n; ++i) {
+    out[i].altitudeCm = altitudeFromReciprocal(in[i].pressurePa, reciprocal);
+    out[i].seaLevelPa = seaLevelPressurePa(in[i].pressurePa, config.stationAltitudeCm);
+    out[i].dewPointC_x100 = dewPointC_x100(in[i].tempC_x100, in[i].humidityPct_x1024);
+    out[i].absHumidity_mgm3 = absoluteHumidity_mgm3(in[i].tempC_x100, in[i].humidityPct_x1024);
+  }
+  return Status::Ok();
+}
+
+} // namespace derived
+} // namespace BME280
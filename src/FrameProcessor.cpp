@@ -0,0 +1,57 @@
+/// @file FrameProcessor.cpp
+/// @brief Raw-frame processing stage
+
+#include "BME280/FrameProcessor.h"
+
+namespace BME280 {
+
+void FrameProcessor::configure(const Calibration& calib, Channels channels,
+                               const SampleFilterConfig& filter) {
+  comp::prepareCalibration(calib, _prep);
+  _channels = channels;
+  _filter.configure(filter);
+  _errors = 0;
+}
+
+size_t FrameProcessor::process(SpscRing<RawFrame>& ring, TimestampedSample* out,
+                               DerivedSample* derived, size_t maxCount) {
+  if (out == nullptr) {
+    return 0;
+  }
+
+  RawFrame frames[BATCH];
+  CompensatedSample samples[BATCH];
+  const size_t limit = (maxCount < BATCH) ? maxCount : BATCH;
+  size_t count = 0;
+  while (count < limit && ring.pop(frames[count])) {
+    count++;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  const Status st = comp::compensateFrames(_prep, frames, samples, count, _channels);
+  size_t produced = 0;
+  for (size_t i = 0; i < count; ++i) {
+    // Rare: a zero pressure divisor; find the failing frames one by one
+    if (!st.ok() && !comp::compensateFrames(_prep, &frames[i], &samples[i], 1, _channels).ok()) {
+      if (_errors < UINT32_MAX) {
+        _errors++;
+      }
+      continue;
+    }
+    // Compact the good samples to the front for the derived batch
+    _filter.apply(samples[i]);
+    samples[produced] = samples[i];
+    out[produced].timestampMs = frames[i].timestampMs;
+    out[produced].sample = samples[i];
+    produced++;
+  }
+
+  if (derived != nullptr) {
+    derived::derive(samples, derived, produced, _derivedConfig);
+  }
+  return produced;
+}
+
+} // namespace BME280
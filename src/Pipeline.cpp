@@ -0,0 +1,175 @@
+/// @file Pipeline.cpp
+/// @brief Optional dual-core FreeRTOS acquisition/processing pipeline (ESP32)
+
+#include "BME280/Pipeline.h"
+
+#if defined(ESP_PLATFORM)
+
+#include <Arduino.h>
+
+namespace BME280 {
+namespace {
+
+static constexpr uint32_t PROCESSING_WAIT_MS = 100;  // Fallback; pushes and stop() notify
+static constexpr uint32_t STOP_WAIT_MS = 10;         // Recheck if a notification is stray
+
+static TickType_t msToTicksAtLeastOne(uint32_t ms) {
+  const TickType_t ticks = pdMS_TO_TICKS(ms);
+  return (ticks > 0) ? ticks : 1;
+}
+
+} // namespace
+
+Status Pipeline::start(BME280& device, SpscRing<RawFrame>& ring,
+                       const PipelineConfig& config) {
+  if (_running.load(std::memory_order_acquire)) {
+    return Status::Error(Err::BUSY, "Pipeline running");
+  }
+
+  Calibration calib;
+  Status st = device.getCalibration(calib);
+  if (!st.ok()) {
+    return st;
+  }
+  st = device.attachFrameRing(&ring);
+  if (!st.ok()) {
+    return st;
+  }
+
+  _processor.configure(calib, device.channels(), device.sampleFilter());
+  _processor.setDerivedConfig(config.derived);
+  _device = &device;
+  _ring = &ring;
+  _config = config;
+  _stopper = nullptr;
+  _processed.store(0, std::memory_order_relaxed);
+  _errors.store(0, std::memory_order_relaxed);
+  _running.store(true, std::memory_order_release);
+
+  // Processing first so the acquisition task can notify it from its first tick
+  _activeTasks.store(1, std::memory_order_release);
+  if (xTaskCreatePinnedToCore(_processingEntry, "bme280_proc", _config.processingStackBytes,
+                              this, _config.processingPriority, &_processingTask,
+                              _config.processingCore) != pdPASS) {
+    _activeTasks.store(0, std::memory_order_release);
+    _running.store(false, std::memory_order_release);
+    device.detachFrameRing();
+    return Status::Error(Err::INVALID_CONFIG, "Processing task create failed");
+  }
+
+  _activeTasks.fetch_add(1, std::memory_order_acq_rel);
+  if (xTaskCreatePinnedToCore(_acquisitionEntry, "bme280_acq", _config.acquisitionStackBytes,
+                              this, _config.acquisitionPriority, &_acquisitionTask,
+                              _config.acquisitionCore) != pdPASS) {
+    _activeTasks.fetch_sub(1, std::memory_order_acq_rel);
+    stop();
+    return Status::Error(Err::INVALID_CONFIG, "Acquisition task create failed");
+  }
+
+  return Status::Ok();
+}
+
+void Pipeline::stop() {
+  if (_device == nullptr) {
+    return;
+  }
+
+  // Published before _running so an exiting task always sees who to notify
+  _stopper = xTaskGetCurrentTaskHandle();
+  _running.store(false, std::memory_order_release);
+  if (_processingTask != nullptr) {
+    xTaskNotifyGive(_processingTask);
+  }
+  if (_acquisitionTask != nullptr) {
+    xTaskNotifyGive(_acquisitionTask);
+  }
+  while (_activeTasks.load(std::memory_order_acquire) != 0) {
+    ulTaskNotifyTake(pdTRUE, msToTicksAtLeastOne(STOP_WAIT_MS));
+  }
+
+  // Both tasks have exited; the device belongs to the caller again
+  _device->detachFrameRing();
+  _device = nullptr;
+  _ring = nullptr;
+  _acquisitionTask = nullptr;
+  _processingTask = nullptr;
+  _stopper = nullptr;
+}
+
+void Pipeline::_acquisitionEntry(void* arg) {
+  Pipeline* self = static_cast<Pipeline*>(arg);
+  self->_runAcquisition();
+  self->_exitTask();
+}
+
+void Pipeline::_processingEntry(void* arg) {
+  Pipeline* self = static_cast<Pipeline*>(arg);
+  self->_runProcessing();
+  self->_exitTask();
+}
+
+void Pipeline::_exitTask() {
+  // stop() may return and the pipeline be destroyed right after the decrement:
+  // read everything needed first
+  const TaskHandle_t stopper = _stopper;
+  _activeTasks.fetch_sub(1, std::memory_order_acq_rel);
+  if (stopper != nullptr) {
+    xTaskNotifyGive(stopper);
+  }
+  vTaskDelete(nullptr);
+}
+
+void Pipeline::_runAcquisition() {
+  while (_running.load(std::memory_order_acquire)) {
+    if (!_device->measurementPending()) {
+      _device->requestMeasurement();
+    }
+
+    const size_t before = _ring->size();
+    _device->tick(millis());
+    if (_ring->size() != before) {
+      xTaskNotifyGive(_processingTask);
+    }
+
+    // Sleep until the driver will next touch the bus; stop() wakes the task early
+    uint32_t waitMs = _config.idleDelayMs;
+    if (_device->measurementPending()) {
+      const int32_t due = static_cast<int32_t>(_device->nextSampleDueMs() - millis());
+      if (due > static_cast<int32_t>(waitMs)) {
+        waitMs = static_cast<uint32_t>(due);
+      }
+    }
+    ulTaskNotifyTake(pdTRUE, msToTicksAtLeastOne(waitMs));
+  }
+}
+
+void Pipeline::_runProcessing() {
+  TimestampedSample samples[FrameProcessor::BATCH];
+  DerivedSample derived[FrameProcessor::BATCH];
+  DerivedSample* derivedOut = (_config.onDerived != nullptr) ? derived : nullptr;
+
+  for (;;) {
+    const size_t count = _processor.process(*_ring, samples, derivedOut, FrameProcessor::BATCH);
+    _errors.store(_processor.errors(), std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+      _processed.fetch_add(1, std::memory_order_relaxed);
+      if (_config.onSample != nullptr) {
+        _config.onSample(samples[i], _config.user);
+      }
+      if (derivedOut != nullptr) {
+        _config.onDerived(samples[i], derived[i], _config.user);
+      }
+    }
+
+    if (_ring->size() == 0) {
+      if (!_running.load(std::memory_order_acquire)) {
+        break;
+      }
+      ulTaskNotifyTake(pdTRUE, msToTicksAtLeastOne(PROCESSING_WAIT_MS));
+    }
+  }
+}
+
+} // namespace BME280
+
+#endif // ESP_PLATFORM
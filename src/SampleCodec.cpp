@@ -0,0 +1,219 @@
+/// @file SampleCodec.cpp
+/// @brief Delta + zigzag varint stream format
+
+#include "BME280/SampleCodec.h"
+
+namespace BME280 {
+namespace {
+
+static constexpr uint8_t MAGIC_0 = 'B';
+static constexpr uint8_t MAGIC_1 = 'S';
+static constexpr size_t VARINT_MAX = 5;
+
+static uint32_t zigzag(int32_t v) {
+  return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(-static_cast<int32_t>(
+                                               static_cast<uint32_t>(v) >> 31));
+}
+
+static int32_t unzigzag(uint32_t v) {
+  return static_cast<int32_t>((v >> 1) ^ (0U - (v & 1U)));
+}
+
+static size_t putVarint(uint8_t* out, uint32_t v) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = static_cast<uint8_t>(v);
+  return n;
+}
+
+/// Delta in wrapping 32-bit arithmetic; round-trips for any pair of values
+static int32_t wrapDelta(int32_t value, int32_t last) {
+  return static_cast<int32_t>(static_cast<uint32_t>(value) - static_cast<uint32_t>(last));
+}
+
+static int32_t wrapAdd(int32_t last, int32_t delta) {
+  return static_cast<int32_t>(static_cast<uint32_t>(last) + static_cast<uint32_t>(delta));
+}
+
+static void sampleValues(const CompensatedSample& sample, int32_t (&out)[3]) {
+  out[0] = sample.tempC_x100;
+  out[1] = static_cast<int32_t>(sample.pressurePa);
+  out[2] = static_cast<int32_t>(sample.humidityPct_x1024);
+}
+
+/// Channel c in a record, from the stream's own header bits (not the build's)
+static bool channelPresent(Channels channels, size_t c) {
+  const uint8_t bits = static_cast<uint8_t>(channels);
+  return c == 0 || (c == 1 && (bits & CHANNEL_PRESSURE) != 0) ||
+         (c == 2 && (bits & CHANNEL_HUMIDITY) != 0);
+}
+
+} // namespace
+
+Status SampleEncoder::begin(const SampleStreamHeader& header) {
+  if (_buffer == nullptr) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid codec buffer");
+  }
+  if (_capacity - _size < SAMPLE_CODEC_HEADER_SIZE) {
+    return Status::Error(Err::BUSY, "Codec buffer full");
+  }
+
+  // Channels compiled out are never written, so the header must not claim them
+  const Channels channels = static_cast<Channels>(static_cast<uint8_t>(header.channels) &
+                                                  static_cast<uint8_t>(COMPILED_CHANNELS));
+
+  uint8_t* out = _buffer + _size;
+  out[0] = MAGIC_0;
+  out[1] = MAGIC_1;
+  out[2] = SAMPLE_CODEC_VERSION;
+  out[3] = static_cast<uint8_t>(channels);
+  out[4] = static_cast<uint8_t>(header.units);
+  out[5] = static_cast<uint8_t>(header.calibrationId & 0xFF);
+  out[6] = static_cast<uint8_t>(header.calibrationId >> 8);
+  _size += SAMPLE_CODEC_HEADER_SIZE;
+
+  _started = true;
+  _hasRecord = false;
+  _channels = channels;
+  _lastMs = 0;
+  _lastStepMs = 0;
+  for (int32_t& v : _last) {
+    v = 0;
+  }
+  return Status::Ok();
+}
+
+Status SampleEncoder::encode(const CompensatedSample& sample, uint32_t timestampMs) {
+  if (!_started) {
+    return Status::Error(Err::NOT_INITIALIZED, "begin() not called");
+  }
+
+  uint8_t record[SAMPLE_CODEC_MAX_RECORD];
+  const uint32_t stepMs = timestampMs - _lastMs;
+  size_t n = putVarint(record, zigzag(wrapDelta(static_cast<int32_t>(stepMs),
+                                                static_cast<int32_t>(_lastStepMs))));
+  int32_t values[3];
+  sampleValues(sample, values);
+  for (size_t c = 0; c < 3; ++c) {
+    if (channelPresent(_channels, c)) {
+      n += putVarint(record + n, zigzag(wrapDelta(values[c], _last[c])));
+    }
+  }
+
+  if (_capacity - _size < n) {
+    return Status::Error(Err::BUSY, "Codec buffer full");
+  }
+  for (size_t i = 0; i < n; ++i) {
+    _buffer[_size + i] = record[i];
+  }
+  _size += n;
+
+  // The first record carries the absolute time, which is not a sampling step
+  _lastStepMs = _hasRecord ? stepMs : 0;
+  _lastMs = timestampMs;
+  _hasRecord = true;
+  for (size_t c = 0; c < 3; ++c) {
+    if (channelPresent(_channels, c)) {
+      _last[c] = values[c];
+    }
+  }
+  return Status::Ok();
+}
+
+Status SampleDecoder::readHeader(SampleStreamHeader& out) {
+  if (_data == nullptr || _len - _pos < SAMPLE_CODEC_HEADER_SIZE) {
+    return Status::Error(Err::INVALID_PARAM, "Stream header truncated");
+  }
+  const uint8_t* in = _data + _pos;
+  if (in[0] != MAGIC_0 || in[1] != MAGIC_1) {
+    return Status::Error(Err::INVALID_PARAM, "Not a sample stream");
+  }
+  if (in[2] != SAMPLE_CODEC_VERSION ||
+      in[4] != static_cast<uint8_t>(SampleUnits::FIXED_POINT)) {
+    return Status::Error(Err::INVALID_PARAM, "Unsupported stream format");
+  }
+  const uint8_t channels = in[3];
+  if ((channels & static_cast<uint8_t>(Channels::T)) == 0 ||
+      (channels & ~static_cast<uint8_t>(Channels::TPH)) != 0) {
+    return Status::Error(Err::INVALID_PARAM, "Invalid stream channels");
+  }
+
+  out.version = in[2];
+  out.channels = static_cast<Channels>(channels);
+  out.units = static_cast<SampleUnits>(in[4]);
+  out.calibrationId = static_cast<uint16_t>(in[5] | (in[6] << 8));
+  _pos += SAMPLE_CODEC_HEADER_SIZE;
+
+  _started = true;
+  _hasRecord = false;
+  _channels = out.channels;
+  _lastMs = 0;
+  _lastStepMs = 0;
+  for (int32_t& v : _last) {
+    v = 0;
+  }
+  return Status::Ok();
+}
+
+bool SampleDecoder::_readVarint(uint32_t& out) {
+  uint32_t value = 0;
+  for (size_t i = 0; i < VARINT_MAX; ++i) {
+    if (_pos >= _len) {
+      _truncated = true;
+      return false;
+    }
+    const uint8_t byte = _data[_pos++];
+    value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+    if ((byte & 0x80) == 0) {
+      out = value;
+      return true;
+    }
+  }
+  _truncated = true;  // Over-long varint: corrupt stream
+  return false;
+}
+
+bool SampleDecoder::next(CompensatedSample& out, uint32_t& timestampMs) {
+  if (!_started || _truncated || _pos >= _len) {
+    return false;
+  }
+
+  // Decode into locals so a truncated record leaves the state untouched
+  const size_t start = _pos;
+  uint32_t raw = 0;
+  if (!_readVarint(raw)) {
+    _pos = start;
+    return false;
+  }
+  const uint32_t stepMs = static_cast<uint32_t>(wrapAdd(static_cast<int32_t>(_lastStepMs),
+                                                        unzigzag(raw)));
+  int32_t values[3] = {_last[0], _last[1], _last[2]};
+  for (size_t c = 0; c < 3; ++c) {
+    if (!channelPresent(_channels, c)) {
+      values[c] = 0;
+      continue;
+    }
+    if (!_readVarint(raw)) {
+      _pos = start;
+      return false;
+    }
+    values[c] = wrapAdd(_last[c], unzigzag(raw));
+  }
+
+  _lastStepMs = _hasRecord ? stepMs : 0;
+  _lastMs += stepMs;
+  _hasRecord = true;
+  for (size_t c = 0; c < 3; ++c) {
+    _last[c] = values[c];
+  }
+  timestampMs = _lastMs;
+  out.tempC_x100 = values[0];
+  out.pressurePa = static_cast<uint32_t>(values[1]);
+  out.humidityPct_x1024 = static_cast<uint32_t>(values[2]);
+  return true;
+}
+
+} // namespace BME280
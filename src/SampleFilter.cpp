@@ -0,0 +1,90 @@
+/// @file SampleFilter.cpp
+/// @brief Integer median + IIR filter stage
+
+#include "BME280/SampleFilter.h"
+
+namespace BME280 {
+namespace {
+
+static constexpr int32_t IIR_FRAC_BITS = 8;
+
+static bool channelActive(const ChannelFilterConfig& config) {
+  return config.median != MedianTaps::OFF || config.iirShift != 0;
+}
+
+/// Median of n values (lower middle for even n)
+static int32_t median(const int32_t* values, size_t n) {
+  int32_t sorted[5];
+  for (size_t i = 0; i < n; ++i) {
+    int32_t v = values[i];
+    size_t j = i;
+    while (j > 0 && sorted[j - 1] > v) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = v;
+  }
+  return sorted[(n - 1) / 2];
+}
+
+} // namespace
+
+bool SampleFilterConfig::active() const {
+  return channelActive(temperature) || channelActive(pressure) || channelActive(humidity);
+}
+
+void SampleFilter::configure(const SampleFilterConfig& config) {
+  _config = config;
+  reset();
+}
+
+void SampleFilter::reset() {
+  for (ChannelState& state : _state) {
+    state = ChannelState();
+  }
+}
+
+void SampleFilter::apply(CompensatedSample& sample) {
+  sample.tempC_x100 = _applyChannel(_config.temperature, _state[0], sample.tempC_x100);
+  sample.pressurePa = static_cast<uint32_t>(
+      _applyChannel(_config.pressure, _state[1], static_cast<int32_t>(sample.pressurePa)));
+  sample.humidityPct_x1024 = static_cast<uint32_t>(_applyChannel(
+      _config.humidity, _state[2], static_cast<int32_t>(sample.humidityPct_x1024)));
+}
+
+int32_t SampleFilter::_applyChannel(const ChannelFilterConfig& config, ChannelState& state,
+                                    int32_t value) {
+  const size_t taps = static_cast<size_t>(config.median);
+  if (taps > 1 && taps <= MAX_TAPS) {
+    state.history[state.next] = value;
+    state.next = static_cast<uint8_t>((state.next + 1) % taps);
+    if (state.count < taps) {
+      state.count++;
+    }
+    value = median(state.history, state.count);
+  }
+
+  if (config.iirShift == 0) {
+    return value;
+  }
+  const uint8_t shift =
+      (config.iirShift > SAMPLE_IIR_MAX_SHIFT) ? SAMPLE_IIR_MAX_SHIFT : config.iirShift;
+  // Q8 in 64 bits: any int32_t input, including out-of-range compensation output
+  const int64_t inQ8 = static_cast<int64_t>(value) * (1 << IIR_FRAC_BITS);
+  if (!state.seeded) {
+    state.iirQ8 = inQ8;
+    state.seeded = true;
+  } else {
+    const int64_t delta = inQ8 - state.iirQ8;
+    const int64_t round = (static_cast<int64_t>(1) << shift) - 1;
+    // Round the step toward the input so the output settles on a constant input
+    const int64_t step = (delta >= 0) ? (delta + round) >> shift : -((-delta + round) >> shift);
+    state.iirQ8 += step;
+  }
+  // The state stays between past inputs, so the rounded output fits in int32_t
+  const int64_t half = 1 << (IIR_FRAC_BITS - 1);
+  return static_cast<int32_t>((state.iirQ8 >= 0) ? (state.iirQ8 + half) >> IIR_FRAC_BITS
+                                                 : -((-state.iirQ8 + half) >> IIR_FRAC_BITS));
+}
+
+} // namespace BME280
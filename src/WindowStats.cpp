@@ -0,0 +1,222 @@
+/// @file WindowStats.cpp
+/// @brief Incremental windowed statistics
+
+#include "BME280/WindowStats.h"
+
+namespace BME280 {
+namespace {
+
+/// floor(sqrt(v))
+static uint32_t isqrt64(uint64_t v) {
+  uint64_t result = 0;
+  uint64_t bit = static_cast<uint64_t>(1) << 62;
+  while (bit > v) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (v >= result + bit) {
+      v -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint32_t>(result);
+}
+
+/// Round num / den to the nearest integer, ties toward +infinity (den > 0)
+/// Independent of the offset the sums are taken against.
+static int64_t roundDiv(int64_t num, int64_t den) {
+  const int64_t n2 = 2 * num + den;
+  const int64_t d2 = 2 * den;
+  return (n2 >= 0) ? n2 / d2 : -((-n2 + d2 - 1) / d2);
+}
+
+static void sampleValues(const CompensatedSample& sample, int32_t (&out)[3]) {
+  out[0] = sample.tempC_x100;
+  out[1] = static_cast<int32_t>(sample.pressurePa);
+  out[2] = static_cast<int32_t>(sample.humidityPct_x1024);
+}
+
+} // namespace
+
+WindowStats::WindowStats(uint32_t periodMs, uint32_t maxSamples)
+    : _capacity((maxSamples == 0 || maxSamples > WINDOW_MAX_SAMPLES) ? WINDOW_MAX_SAMPLES
+                                                                      : maxSamples),
+      _periodMs(periodMs) {}
+
+WindowStats::WindowStats(Slot* slots, uint32_t* deques, uint32_t capacity)
+    : _slots(slots), _deques(deques), _capacity(capacity), _sliding(true) {}
+
+void WindowStats::reset() {
+  for (Accumulator& acc : _acc) {
+    acc = Accumulator();
+  }
+  _count = 0;
+  _firstMs = 0;
+  _lastMs = 0;
+  _nextSlot = 0;
+  for (size_t d = 0; d < 2 * CHANNELS; ++d) {
+    _dequeHead[d] = 0;
+    _dequeSize[d] = 0;
+  }
+  _last = WindowSummary();
+  _windowsClosed = 0;
+}
+
+void WindowStats::add(const CompensatedSample& sample, uint32_t nowMs) {
+  int32_t values[CHANNELS];
+  sampleValues(sample, values);
+
+  if (!_sliding) {
+    if (_count > 0 && _periodMs > 0 && nowMs - _firstMs >= _periodMs) {
+      _closeWindow();
+    }
+    if (_count == 0) {
+      _firstMs = nowMs;
+    }
+    _lastMs = nowMs;
+    _accumulate(values);
+    if (_count >= _capacity) {
+      _closeWindow();
+    }
+    return;
+  }
+
+  if (_count == _capacity) {
+    _evictOldest();
+  }
+  // The evicted slot (if any) is the one the new sample takes
+  const uint32_t index = _nextSlot;
+  _nextSlot = (index + 1 == _capacity) ? 0 : index + 1;
+  Slot& slot = _slots[index];
+  for (size_t c = 0; c < CHANNELS; ++c) {
+    slot.value[c] = values[c];
+    _dequePush(c, index, values[c], false);
+    _dequePush(CHANNELS + c, index, values[c], true);
+  }
+  slot.timeMs = nowMs;
+  _lastMs = nowMs;
+  _accumulate(values);
+  _firstMs = _slots[_oldestSlot()].timeMs;
+}
+
+uint32_t WindowStats::_oldestSlot() const {
+  return (_nextSlot + _capacity - _count) % _capacity;
+}
+
+void WindowStats::_accumulate(const int32_t (&values)[CHANNELS]) {
+  for (size_t c = 0; c < CHANNELS; ++c) {
+    Accumulator& acc = _acc[c];
+    if (_count == 0) {
+      acc.offset = values[c];
+      acc.sum = 0;
+      acc.sumSq = 0;
+      acc.min = values[c];
+      acc.max = values[c];
+    }
+    const int64_t d = static_cast<int64_t>(values[c]) - acc.offset;
+    acc.sum += d;
+    acc.sumSq += static_cast<uint64_t>(d * d);
+    if (values[c] < acc.min) {
+      acc.min = values[c];
+    }
+    if (values[c] > acc.max) {
+      acc.max = values[c];
+    }
+  }
+  _count++;
+}
+
+void WindowStats::_evictOldest() {
+  const uint32_t oldest = _oldestSlot();
+  const Slot& slot = _slots[oldest];
+  for (size_t c = 0; c < CHANNELS; ++c) {
+    Accumulator& acc = _acc[c];
+    const int64_t d = static_cast<int64_t>(slot.value[c]) - acc.offset;
+    acc.sum -= d;
+    acc.sumSq -= static_cast<uint64_t>(d * d);
+  }
+  for (size_t d = 0; d < 2 * CHANNELS; ++d) {
+    if (_dequeSize[d] > 0 && _deque(d)[_dequeHead[d]] == oldest) {
+      _dequeHead[d] = (_dequeHead[d] + 1) % _capacity;
+      _dequeSize[d]--;
+    }
+  }
+  _count--;
+}
+
+void WindowStats::_dequePush(size_t d, uint32_t index, int32_t value, bool isMax) {
+  uint32_t* deque = _deque(d);
+  const size_t c = d % CHANNELS;
+  // Drop entries that can no longer be the extreme while the new sample is in the window
+  while (_dequeSize[d] > 0) {
+    const uint32_t backIdx = (_dequeHead[d] + _dequeSize[d] - 1) % _capacity;
+    const int32_t back = _slots[deque[backIdx]].value[c];
+    if (isMax ? (back > value) : (back < value)) {
+      break;
+    }
+    _dequeSize[d]--;
+  }
+  deque[(_dequeHead[d] + _dequeSize[d]) % _capacity] = index;
+  _dequeSize[d]++;
+}
+
+int32_t WindowStats::_dequeFront(size_t d) const {
+  return _slots[_deque(d)[_dequeHead[d]]].value[d % CHANNELS];
+}
+
+void WindowStats::_summarize(WindowSummary& out) const {
+  out.count = _count;
+  out.firstMs = _firstMs;
+  out.lastMs = _lastMs;
+  ChannelSummary* channels[CHANNELS] = {&out.temperature, &out.pressure, &out.humidity};
+  const int64_t n = _count;
+  for (size_t c = 0; c < CHANNELS; ++c) {
+    const Accumulator& acc = _acc[c];
+    ChannelSummary& ch = *channels[c];
+    ch.mean = static_cast<int32_t>(acc.offset + roundDiv(acc.sum, n));
+    // sum^2 / n without overflow: (q * n + r) * sum / n = q * sum + r * sum / n
+    const int64_t q = acc.sum / n;
+    const int64_t r = acc.sum % n;
+    const uint64_t sumSqOverN = static_cast<uint64_t>(q * acc.sum + (r * acc.sum) / n);
+    ch.variance = (acc.sumSq > sumSqOverN) ? (acc.sumSq - sumSqOverN) / static_cast<uint64_t>(n)
+                                           : 0;
+    ch.stddev = isqrt64(ch.variance);
+    if (_sliding) {
+      ch.min = _dequeFront(c);
+      ch.max = _dequeFront(CHANNELS + c);
+    } else {
+      ch.min = acc.min;
+      ch.max = acc.max;
+    }
+  }
+}
+
+bool WindowStats::summary(WindowSummary& out) const {
+  if (_count == 0) {
+    return false;
+  }
+  _summarize(out);
+  return true;
+}
+
+bool WindowStats::lastWindow(WindowSummary& out) const {
+  if (_windowsClosed == 0) {
+    return false;
+  }
+  out = _last;
+  return true;
+}
+
+void WindowStats::_closeWindow() {
+  _summarize(_last);
+  _windowsClosed++;
+  _count = 0;
+  if (_callback != nullptr) {
+    _callback(_last, _user);
+  }
+}
+
+} // namespace BME280
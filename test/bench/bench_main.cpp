@@ -0,0 +1,184 @@
+/// @file bench_main.cpp
+/// @brief Host-native benchmarks against the simulated BME280
+///
+/// Build and run: pio run -e bench_native -t exec
+/// Each result is printed as "BENCH <metric> <value> <lower|higher>", where the last
+/// field is the better direction. Compare two runs with scripts/bench_compare.py.
+
+#include <chrono>
+#include <cstdio>
+
+#include "Arduino.h"
+#include "BME280/BME280.h"
+#include "BME280/Derived.h"
+#include "../sim/SimBme280.h"
+
+SerialClass Serial;
+
+using namespace BME280;
+
+namespace {
+
+static constexpr uint32_t LOOP_STEP_US = 100;
+static constexpr uint32_t RUN_US = 10000000;  // 10 s simulated per scenario
+static constexpr size_t COMP_SAMPLES = 4096;
+static constexpr uint32_t COMP_ROUNDS = 200;
+
+static void report(const char* metric, double value, const char* better) {
+  printf("BENCH %s %.3f %s\n", metric, value, better);
+}
+
+static void reportScenario(const char* scenario, const char* metric, double value,
+                           const char* better) {
+  char name[96];
+  snprintf(name, sizeof(name), "%s.%s", scenario, metric);
+  report(name, value, better);
+}
+
+struct Scenario {
+  const char* name;
+  Mode mode;
+  bool fusedRead;
+  bool autoRearm;
+  Oversampling osrsP;
+  Oversampling osrsH;
+  uint32_t nackEvery;
+};
+
+static const Scenario SCENARIOS[] = {
+  {"forced", Mode::FORCED, false, false, Oversampling::X1, Oversampling::X1, 0},
+  {"forced_fused", Mode::FORCED, true, false, Oversampling::X1, Oversampling::X1, 0},
+  {"forced_rearm", Mode::FORCED, false, true, Oversampling::X1, Oversampling::X1, 0},
+  {"forced_rearm_fused", Mode::FORCED, true, true, Oversampling::X1, Oversampling::X1, 0},
+  {"forced_t_only", Mode::FORCED, false, false, Oversampling::SKIP, Oversampling::SKIP, 0},
+  {"forced_nack2pct", Mode::FORCED, false, false, Oversampling::X1, Oversampling::X1, 50},
+  {"normal", Mode::NORMAL, false, false, Oversampling::X1, Oversampling::X1, 0},
+  {"normal_fused", Mode::NORMAL, true, false, Oversampling::X1, Oversampling::X1, 0},
+};
+
+/// Application loop: request, tick every LOOP_STEP_US, collect samples
+static bool runScenario(const Scenario& sc) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  cfg.mode = sc.mode;
+  cfg.osrsP = sc.osrsP;
+  cfg.osrsH = sc.osrsH;
+  cfg.standby = Standby::MS_0_5;
+  cfg.fusedRead = sc.fusedRead;
+  cfg.forcedAutoRearm = sc.autoRearm;
+
+  BME280::BME280 driver;
+  const Status st = driver.begin(cfg);
+  if (!st.ok()) {
+    printf("# %s: begin failed: %s\n", sc.name, st.message());
+    return false;
+  }
+
+  dev.resetCounters();
+#if BME280_ENABLE_INSTRUMENTATION
+  driver.resetBusStats();
+#endif
+  dev.nackEvery(sc.nackEvery);
+  const uint64_t endUs = dev.nowUs() + RUN_US;
+  uint32_t samples = 0;
+  while (dev.nowUs() < endUs) {
+    if (!driver.measurementReady()) {
+      driver.requestMeasurement();
+    }
+    driver.tick(dev.nowMs());
+    CompensatedSample m;
+    if (driver.getMeasurement(m).ok()) {
+      samples++;
+    }
+    dev.advanceUs(LOOP_STEP_US);
+  }
+
+  const sim::SimBme280::Counters& c = dev.counters();
+  const double perSample = (samples > 0) ? 1.0 / samples : 0.0;
+  reportScenario(sc.name, "samples_per_s", samples * 1e6 / RUN_US, "higher");
+  reportScenario(sc.name, "transactions_per_sample", (c.reads + c.writes) * perSample, "lower");
+  reportScenario(sc.name, "bytes_per_sample", c.bytes * perSample, "lower");
+#if BME280_ENABLE_INSTRUMENTATION
+  const BusStats& bus = driver.busStats();
+  uint32_t busUs = 0;
+  for (size_t i = 0; i < BUS_OP_COUNT; ++i) {
+    busUs += bus.ops[i].totalUs;
+  }
+  reportScenario(sc.name, "bus_us_per_sample", busUs * perSample, "lower");
+  reportScenario(sc.name, "status_polls_per_sample",
+                 bus.ops[static_cast<size_t>(BusOp::STATUS_POLL)].count * perSample, "lower");
+#endif
+  if (c.ignoredConfigWrites != 0) {
+    printf("# %s: %u config writes ignored in NORMAL mode\n", sc.name,
+           static_cast<unsigned>(c.ignoredConfigWrites));
+  }
+  return samples > 0;
+}
+
+template <typename Fn>
+static double nsPerSample(Fn fn) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t round = 0; round < COMP_ROUNDS; ++round) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  return ns / (static_cast<double>(COMP_ROUNDS) * COMP_SAMPLES);
+}
+
+static void runCompensation() {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  if (!driver.begin(cfg).ok()) {
+    printf("# compensation: begin failed\n");
+    return;
+  }
+  Calibration calib;
+  driver.getCalibration(calib);
+  PreparedCalibration prep;
+  comp::prepareCalibration(calib, prep);
+
+  static RawSample raw[COMP_SAMPLES];
+  static CompensatedSample out[COMP_SAMPLES];
+  static DerivedSample derivedOut[COMP_SAMPLES];
+  for (size_t i = 0; i < COMP_SAMPLES; ++i) {
+    raw[i].adcT = 480000 + static_cast<int32_t>((i * 7919) % 80000);
+    raw[i].adcP = 300000 + static_cast<int32_t>((i * 104729) % 200000);
+    raw[i].adcH = 20000 + static_cast<int32_t>((i * 613) % 30000);
+  }
+
+  volatile uint32_t sink = 0;
+  report("compensate.ns_per_sample", nsPerSample([&]() {
+    int32_t tFine = 0;
+    for (size_t i = 0; i < COMP_SAMPLES; ++i) {
+      comp::compensate(calib, raw[i], out[i], tFine);
+    }
+    sink = sink + out[COMP_SAMPLES - 1].pressurePa;
+  }), "lower");
+  report("compensate_batch.ns_per_sample", nsPerSample([&]() {
+    comp::compensateBatch(prep, raw, out, COMP_SAMPLES);
+    sink = sink + out[COMP_SAMPLES - 1].pressurePa;
+  }), "lower");
+  report("derive_batch.ns_per_sample", nsPerSample([&]() {
+    derived::derive(out, derivedOut, COMP_SAMPLES);
+    sink = sink + derivedOut[COMP_SAMPLES - 1].absHumidity_mgm3;
+  }), "lower");
+  (void)sink;
+}
+
+} // namespace
+
+int main() {
+  printf("# BME280 native benchmark (backend %d, %u us loop step, %u s per scenario)\n",
+         BME280_COMPENSATION, LOOP_STEP_US, RUN_US / 1000000);
+
+  bool ok = true;
+  for (const Scenario& sc : SCENARIOS) {
+    ok = runScenario(sc) && ok;
+  }
+  runCompensation();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Host-side checks for scripts/decode_samples.py.
+
+Usage:
+    python3 -m unittest discover -s test/host
+
+GOLDEN_STREAM is the SampleEncoder output checked byte for byte by the native
+test sample_codec_golden_stream (test/native/test_basic.cpp); keep both in sync.
+"""
+
+import io
+import os
+import sys
+import tempfile
+import unittest
+from contextlib import redirect_stdout
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..", "..", "scripts"))
+import decode_samples  # noqa: E402
+
+GOLDEN_STREAM = bytes([
+    0x42, 0x53, 0x01, 0x07, 0x00, 0x3C, 0x5A, 0xC0, 0xA9, 0x07, 0x98, 0x27,
+    0x9A, 0xAF, 0x0C, 0x80, 0xE0, 0x05, 0xD0, 0x0F, 0x02, 0x04, 0x07, 0x00,
+    0x03, 0x05, 0x0C, 0x14, 0xC1, 0x29, 0xDB, 0x16, 0xFC, 0xDF, 0x06,
+])
+
+GOLDEN_RAW = [
+    (60000, [2508, 101325, 47104]),
+    (61000, [2509, 101327, 47100]),
+    (62000, [2507, 101324, 47106]),
+    (63010, [-150, 99870, 102400]),
+]
+
+GOLDEN_CSV = [
+    "timestamp_ms,temperature,pressure,humidity",
+    "60000,25.08,1013.25,46.00",
+    "61000,25.09,1013.27,46.00",
+    "62000,25.07,1013.24,46.00",
+    "63010,-1.50,998.70,100.00",
+]
+
+
+def run_script(data, *args):
+    with tempfile.NamedTemporaryFile(suffix=".bin", delete=False) as handle:
+        handle.write(data)
+        path = handle.name
+    out = io.StringIO()
+    try:
+        sys.argv = ["decode_samples.py", path] + list(args)
+        with redirect_stdout(out):
+            code = decode_samples.main()
+    finally:
+        os.unlink(path)
+    return code, out.getvalue().splitlines()
+
+
+class DecodeSamplesTest(unittest.TestCase):
+    def test_header(self):
+        header = decode_samples.read_header(GOLDEN_STREAM)
+        self.assertEqual(header["channels"], 0x07)
+        self.assertEqual(header["calibration_id"], 0x5A3C)
+
+    def test_raw_values(self):
+        self.assertEqual(list(decode_samples.decode(GOLDEN_STREAM)), GOLDEN_RAW)
+
+    def test_scaled_csv(self):
+        code, lines = run_script(GOLDEN_STREAM)
+        self.assertEqual(code, 0)
+        self.assertEqual(lines[0], "# calibration_id 0x5a3c channels 0x07")
+        self.assertEqual(lines[1:], GOLDEN_CSV)
+
+    def test_truncated_record(self):
+        code, lines = run_script(GOLDEN_STREAM[:-1], "--raw")
+        self.assertEqual(code, 1)
+        self.assertEqual(len(lines), 2 + len(GOLDEN_RAW) - 1)
+
+    def test_bad_magic(self):
+        with self.assertRaises(decode_samples.StreamError):
+            decode_samples.read_header(b"XX" + GOLDEN_STREAM[2:])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -3,6 +3,8 @@
 
 #include <cstdio>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 
 // Include stubs first
 #include "Arduino.h"
@@ -15,6 +17,18 @@ TwoWire Wire;
 // Include driver
 #include "BME280/Status.h"
 #include "BME280/Config.h"
+#include "BME280/Compensation.h"
+#include "BME280/Derived.h"
+#include "BME280/SpscRing.h"
+#include "BME280/WindowStats.h"
+#include "BME280/BME280.h"
+#include "BME280/AdaptiveOversampling.h"
+#include "BME280/SampleCodec.h"
+#include "BME280/Group.h"
+#include "BME280/FrameProcessor.h"
+#include "../sim/SimBme280.h"
+#include "../sim/SimAsyncI2c.h"
+#include "../sim/SimBus.h"
 
 using namespace BME280;
 
@@ -31,10 +45,7 @@ static int testsFailed = 0;
   test_##name(); \
   printf("PASSED\n"); \
   testsPassed++; \
-} catch (...) { \
-  printf("FAILED\n"); \
-  testsFailed++; \
-}
+} while (0)
 
 #define ASSERT_TRUE(x) assert(x)
 #define ASSERT_FALSE(x) assert(!(x))
@@ -45,6 +56,24 @@ static int testsFailed = 0;
 // Tests
 // ============================================================================
 
+/// Datasheet example calibration
+static Calibration exampleCalibration() {
+  Calibration c;
+  c.digT1 = 27504; c.digT2 = 26435; c.digT3 = -1000;
+  c.digP1 = 36477; c.digP2 = -10685; c.digP3 = 3024; c.digP4 = 2855; c.digP5 = 140;
+  c.digP6 = -7; c.digP7 = 15500; c.digP8 = -14600; c.digP9 = 6000;
+  c.digH1 = 75; c.digH2 = 362; c.digH3 = 0; c.digH4 = 313; c.digH5 = 50; c.digH6 = 30;
+  return c;
+}
+
+static uint32_t absDiff(uint32_t a, uint32_t b) {
+  return a > b ? a - b : b - a;
+}
+
+static int32_t absDiffSigned(int32_t a, int32_t b) {
+  return a > b ? a - b : b - a;
+}
+
 TEST(status_ok) {
   Status st = Status::Ok();
   ASSERT_TRUE(st.ok());
@@ -64,19 +93,1761 @@ TEST(status_in_progress) {
   ASSERT_EQ(st.code, Err::IN_PROGRESS);
 }
 
+TEST(status_profile) {
+  const Status st = Status::Error(Err::BUSY, "Busy", 100000);
+#if BME280_ENABLE_STATUS_MESSAGES
+  ASSERT_EQ(st.detail, 100000);
+  ASSERT_EQ(st.message()[0], 'B');
+#else
+  static_assert(sizeof(Status) == 4, "Compact Status must stay 4 bytes");
+  ASSERT_EQ(st.detail, INT16_MAX);
+  ASSERT_EQ(st.message()[0], '\0');
+#endif
+}
+
 TEST(config_defaults) {
   Config cfg;
   ASSERT_EQ(cfg.i2cWrite, nullptr);
   ASSERT_EQ(cfg.i2cWriteRead, nullptr);
   ASSERT_EQ(cfg.i2cAddress, 0x76);
   ASSERT_EQ(cfg.i2cTimeoutMs, 50);
+  ASSERT_EQ(static_cast<uint8_t>(cfg.bus), static_cast<uint8_t>(BusType::I2C));
+  ASSERT_EQ(cfg.spiWrite, nullptr);
+  ASSERT_EQ(cfg.spiWriteRead, nullptr);
   ASSERT_EQ(cfg.offlineThreshold, 5);
   ASSERT_EQ(static_cast<uint8_t>(cfg.osrsT), static_cast<uint8_t>(Oversampling::X1));
-  ASSERT_EQ(static_cast<uint8_t>(cfg.osrsP), static_cast<uint8_t>(Oversampling::X1));
-  ASSERT_EQ(static_cast<uint8_t>(cfg.osrsH), static_cast<uint8_t>(Oversampling::X1));
+  ASSERT_EQ(static_cast<uint8_t>(cfg.osrsP), static_cast<uint8_t>(DEFAULT_OSRS_P));
+  ASSERT_EQ(static_cast<uint8_t>(cfg.osrsH), static_cast<uint8_t>(DEFAULT_OSRS_H));
   ASSERT_EQ(static_cast<uint8_t>(cfg.filter), static_cast<uint8_t>(Filter::OFF));
   ASSERT_EQ(static_cast<uint8_t>(cfg.standby), static_cast<uint8_t>(Standby::MS_125));
   ASSERT_EQ(static_cast<uint8_t>(cfg.mode), static_cast<uint8_t>(Mode::FORCED));
+  ASSERT_EQ(cfg.clockUs, nullptr);
+  ASSERT_EQ(cfg.measurementMarginUs, 1000u);
+  ASSERT_FALSE(cfg.fusedRead);
+  ASSERT_FALSE(cfg.forcedAutoRearm);
+  ASSERT_TRUE(cfg.calibSpotCheck);
+}
+
+TEST(compensation_int64_reference) {
+  const Calibration calib = exampleCalibration();
+  RawSample raw;
+  raw.adcT = 519888;
+  raw.adcP = 415148;
+  raw.adcH = 30000;
+  CompensatedSample out;
+  int32_t tFine = 0;
+  ASSERT_TRUE(comp::compensateInt64(calib, raw, out, tFine).ok());
+  ASSERT_EQ(tFine, 128422);
+  ASSERT_EQ(out.tempC_x100, 2508);
+  ASSERT_EQ(out.pressurePa, 100653u);
+}
+
+TEST(compensation_int32_matches_int64) {
+  const Calibration calib = exampleCalibration();
+  for (int32_t adcT = 380000; adcT <= 640000; adcT += 20000) {
+    for (int32_t adcP = 250000; adcP <= 550000; adcP += 25000) {
+      for (int32_t adcH = 5000; adcH <= 50000; adcH += 5000) {
+        RawSample raw;
+        raw.adcT = adcT;
+        raw.adcP = adcP;
+        raw.adcH = adcH;
+        CompensatedSample ref;
+        CompensatedSample out;
+        int32_t refFine = 0;
+        int32_t outFine = 0;
+        ASSERT_TRUE(comp::compensateInt64(calib, raw, ref, refFine).ok());
+        ASSERT_TRUE(comp::compensateInt32(calib, raw, out, outFine).ok());
+        ASSERT_EQ(outFine, refFine);
+        ASSERT_EQ(out.tempC_x100, ref.tempC_x100);
+        ASSERT_EQ(out.humidityPct_x1024, ref.humidityPct_x1024);
+        if (ref.pressurePa >= 30000u && ref.pressurePa <= 110000u) {
+          ASSERT_TRUE(absDiff(out.pressurePa, ref.pressurePa) <= 6);
+        }
+      }
+    }
+  }
+}
+
+TEST(compensation_float_within_tolerance) {
+  const Calibration calib = exampleCalibration();
+  for (int32_t adcT = 380000; adcT <= 640000; adcT += 20000) {
+    for (int32_t adcP = 250000; adcP <= 550000; adcP += 25000) {
+      for (int32_t adcH = 5000; adcH <= 50000; adcH += 5000) {
+        RawSample raw;
+        raw.adcT = adcT;
+        raw.adcP = adcP;
+        raw.adcH = adcH;
+        CompensatedSample ref;
+        CompensatedSample out;
+        int32_t refFine = 0;
+        int32_t outFine = 0;
+        ASSERT_TRUE(comp::compensateInt64(calib, raw, ref, refFine).ok());
+        ASSERT_TRUE(comp::compensateFloat(calib, raw, out, outFine).ok());
+        ASSERT_TRUE(absDiff(static_cast<uint32_t>(out.tempC_x100),
+                            static_cast<uint32_t>(ref.tempC_x100)) <= 1);
+        ASSERT_TRUE(absDiff(out.pressurePa, ref.pressurePa) <= 2);
+        ASSERT_TRUE(absDiff(out.humidityPct_x1024, ref.humidityPct_x1024) <= 12);
+      }
+    }
+  }
+}
+
+TEST(compensation_batch_matches_single) {
+  const Calibration calib = exampleCalibration();
+  static constexpr size_t N = 70;  // not a multiple of the internal chunk size
+  RawSample raw[N];
+  for (size_t i = 0; i < N; ++i) {
+    raw[i].adcT = 400000 + static_cast<int32_t>(i) * 3001;
+    raw[i].adcP = 300000 + static_cast<int32_t>(i) * 2503;
+    raw[i].adcH = 10000 + static_cast<int32_t>(i) * 499;
+  }
+
+  CompensatedSample batch[N];
+  ASSERT_TRUE(comp::compensateBatch(calib, raw, batch, N).ok());
+  for (size_t i = 0; i < N; ++i) {
+    CompensatedSample single;
+    int32_t tFine = 0;
+    ASSERT_TRUE(comp::compensate(calib, raw[i], single, tFine).ok());
+    ASSERT_EQ(batch[i].tempC_x100, single.tempC_x100);
+    ASSERT_EQ(batch[i].pressurePa, single.pressurePa);
+    ASSERT_EQ(batch[i].humidityPct_x1024, single.humidityPct_x1024);
+  }
+}
+
+TEST(compensation_skipped_channels) {
+  const Calibration calib = exampleCalibration();
+  RawSample raw;
+  raw.adcT = 519888;
+  raw.adcP = 415148;
+  raw.adcH = 30000;
+
+  CompensatedSample full;
+  CompensatedSample part;
+  int32_t fullFine = 0;
+  int32_t partFine = 0;
+  ASSERT_TRUE(comp::compensate(calib, raw, full, fullFine).ok());
+
+  ASSERT_TRUE(comp::compensate(calib, raw, part, partFine, Channels::T).ok());
+  ASSERT_EQ(partFine, fullFine);
+  ASSERT_EQ(part.tempC_x100, full.tempC_x100);
+  ASSERT_EQ(part.pressurePa, 0u);
+  ASSERT_EQ(part.humidityPct_x1024, 0u);
+
+  ASSERT_TRUE(comp::compensate(calib, raw, part, partFine, Channels::TP).ok());
+  ASSERT_EQ(part.pressurePa, full.pressurePa);
+  ASSERT_EQ(part.humidityPct_x1024, 0u);
+
+  // A skipped pressure channel cannot fail on a zero divisor
+  Calibration broken = calib;
+  broken.digP1 = 0;
+  ASSERT_FALSE(comp::compensate(broken, raw, part, partFine).ok());
+  ASSERT_TRUE(comp::compensate(broken, raw, part, partFine, Channels::TH).ok());
+  ASSERT_EQ(part.humidityPct_x1024, full.humidityPct_x1024);
+
+  CompensatedSample batch[1];
+  ASSERT_TRUE(comp::compensateBatch(calib, &raw, batch, 1, Channels::TH).ok());
+  ASSERT_EQ(batch[0].tempC_x100, full.tempC_x100);
+  ASSERT_EQ(batch[0].pressurePa, 0u);
+  ASSERT_EQ(batch[0].humidityPct_x1024, full.humidityPct_x1024);
+}
+
+TEST(derived_reference_values) {
+  // Double-precision references: barometric formula and Magnus (b=17.62, c=243.12)
+  ASSERT_TRUE(absDiffSigned(derived::altitudeCm(STANDARD_SEA_LEVEL_PA), 0) <= 1);
+  ASSERT_TRUE(absDiffSigned(derived::altitudeCm(89875), 99996) <= 13);
+  ASSERT_TRUE(absDiffSigned(derived::altitudeCm(30000), 916395) <= 13);
+  ASSERT_EQ(derived::altitudeCm(0), 0);
+  ASSERT_TRUE(absDiff(derived::seaLevelPressurePa(89875, 99996), STANDARD_SEA_LEVEL_PA) <= 3);
+  ASSERT_TRUE(absDiffSigned(derived::dewPointC_x100(2500, 50 * 1024), 1385) <= 3);
+  ASSERT_TRUE(absDiffSigned(derived::dewPointC_x100(-1000, 80 * 1024), -1280) <= 3);
+  ASSERT_EQ(derived::dewPointC_x100(2500, 0), -6000);
+  ASSERT_TRUE(absDiff(derived::absoluteHumidity_mgm3(2500, 50 * 1024), 11483) <= 23);
+}
+
+TEST(derived_batch_matches_single) {
+  static constexpr size_t N = 40;
+  CompensatedSample in[N];
+  for (size_t i = 0; i < N; ++i) {
+    in[i].tempC_x100 = -3000 + static_cast<int32_t>(i) * 277;
+    in[i].pressurePa = 60000 + static_cast<uint32_t>(i) * 1231;
+    in[i].humidityPct_x1024 = 2048 + static_cast<uint32_t>(i) * 2500;
+  }
+  DerivedConfig config;
+  config.seaLevelPa = 102000;
+  config.stationAltitudeCm = 35000;
+
+  DerivedSample batch[N];
+  ASSERT_TRUE(derived::derive(in, batch, N, config).ok());
+  for (size_t i = 0; i < N; ++i) {
+    DerivedSample single;
+    derived::derive(in[i], single, config);
+    ASSERT_EQ(batch[i].altitudeCm, single.altitudeCm);
+    ASSERT_EQ(batch[i].seaLevelPa, single.seaLevelPa);
+    ASSERT_EQ(batch[i].dewPointC_x100, single.dewPointC_x100);
+    ASSERT_EQ(batch[i].absHumidity_mgm3, single.absHumidity_mgm3);
+    ASSERT_EQ(single.altitudeCm, derived::altitudeCm(in[i].pressurePa, config.seaLevelPa));
+  }
+  ASSERT_EQ(derived::derive(nullptr, batch, 1, config).code, Err::INVALID_PARAM);
+}
+
+TEST(sim_forced_measurement) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  ASSERT_EQ(driver.state(), DriverState::READY);
+  TumblingWindowStats window(0, 1);
+  ASSERT_TRUE(driver.attachWindowStats(&window).ok());
+
+  // Nothing is due until a measurement is requested, and again once it is read
+  ASSERT_EQ(driver.nextSampleDueMs(), NO_SAMPLE_DUE_MS);
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+  ASSERT_EQ(driver.nextSampleDueMs(), dev.nowMs() + driver.estimateMeasurementTimeMs());
+  for (int i = 0; i < 200 && !driver.measurementReady(); ++i) {
+    dev.advanceUs(100);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_TRUE(driver.measurementReady());
+  ASSERT_EQ(driver.nextSampleDueMs(), NO_SAMPLE_DUE_MS);
+  CompensatedSample sample;
+  ASSERT_TRUE(driver.getCompensatedSample(sample).ok());
+  WindowSummary summary;
+  ASSERT_TRUE(window.lastWindow(summary));
+  ASSERT_EQ(summary.temperature.mean, sample.tempC_x100);
+  // Datasheet example: 25.08 degC, 100653 Pa (within the backend tolerances)
+  ASSERT_TRUE(absDiffSigned(sample.tempC_x100, 2508) <= 1);
+  ASSERT_TRUE(absDiff(sample.pressurePa, 100653) <= 6);
+  ASSERT_EQ(dev.counters().conversions, 1u);
+  CompensatedSample consumed;
+  ASSERT_TRUE(driver.getMeasurement(consumed).ok());
+  ASSERT_EQ(consumed.pressurePa, sample.pressurePa);
+  ASSERT_FALSE(driver.measurementReady());
+
+#if BME280_ENABLE_DIAGNOSTICS
+  // One NACK degrades the driver; the next successful access restores it
+  dev.injectNacks(1);
+  uint8_t id = 0;
+  ASSERT_FALSE(driver.readChipId(id).ok());
+  ASSERT_EQ(driver.state(), DriverState::DEGRADED);
+  ASSERT_TRUE(driver.readChipId(id).ok());
+  ASSERT_EQ(id, sim::SimBme280::CHIP_ID);
+  ASSERT_EQ(driver.state(), DriverState::READY);
+#endif
+}
+
+TEST(sim_forced_settings_restart) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+  dev.advanceUs(1000);
+
+  // Mid-conversion: sleep first, then config, then the trigger again
+  dev.resetCounters();
+  ASSERT_TRUE(driver.setFilter(Filter::X4).ok());
+  ASSERT_EQ(dev.counters().writes, 1u);
+  ASSERT_EQ(dev.accessCount(), size_t{3});
+  ASSERT_EQ(dev.access(0).reg, 0xF4);
+  ASSERT_EQ(dev.access(0).value & 0x03, 0x00);
+  ASSERT_EQ(dev.access(1).reg, 0xF5);
+  ASSERT_EQ(dev.access(2).reg, 0xF4);
+  ASSERT_EQ(dev.access(2).value & 0x03, 0x01);
+
+  // An unchanged setting does not disturb the running conversion
+  dev.resetCounters();
+  ASSERT_TRUE(driver.setFilter(Filter::X4).ok());
+  ASSERT_EQ(dev.counters().writes, 0u);
+
+  for (int i = 0; i < 200 && !driver.measurementReady(); ++i) {
+    dev.advanceUs(100);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_TRUE(driver.measurementReady());
+  ASSERT_EQ(dev.counters().conversions, 1u);
+  ASSERT_EQ((dev.reg(0xF5) >> 2) & 0x07, static_cast<uint8_t>(Filter::X4));
+}
+
+TEST(sim_forced_long_stall) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  dev.advanceUs(0xFFFFF000u);
+
+  // Trigger just before the 32-bit microsecond wrap
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+  driver.tick(dev.nowMs());
+  ASSERT_FALSE(driver.measurementReady());
+
+  // No tick for more than 2^31 us: the elapsed time must still count as reached
+  dev.advanceUs(0x90000000u);
+  driver.tick(dev.nowMs());
+  ASSERT_TRUE(driver.measurementReady());
+  ASSERT_EQ(dev.counters().conversions, 1u);
+}
+
+/// CRC-16/CCITT-FALSE, the blob checksum, for re-sealing edited blobs
+static void resealBlob(CalibrationBlob& blob) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i + 2 < CALIBRATION_BLOB_SIZE; ++i) {
+    crc = static_cast<uint16_t>(crc ^ (blob.data[i] << 8));
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                           : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  blob.data[CALIBRATION_BLOB_SIZE - 2] = static_cast<uint8_t>(crc & 0xFF);
+  blob.data[CALIBRATION_BLOB_SIZE - 1] = static_cast<uint8_t>(crc >> 8);
+}
+
+static bool readsCalibration(const sim::SimBme280& dev) {
+  for (size_t i = 0; i < dev.accessCount(); ++i) {
+    const sim::SimBme280::Access& a = dev.access(i);
+    if (a.write) {
+      continue;
+    }
+    // The dig_T1 spot check reads 0x88..0x89 only
+    if ((a.reg == 0x88 && a.value > 2) || (a.reg > 0x88 && a.reg <= 0xA1) ||
+        (a.reg >= 0xE1 && a.reg <= 0xE7)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST(sim_calibration_warm_boot) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 cold;
+  ASSERT_TRUE(cold.begin(cfg).ok());
+  CalibrationBlob blob;
+  ASSERT_TRUE(cold.exportCalibration(blob).ok());
+  Calibration coldCalib;
+  ASSERT_TRUE(cold.getCalibration(coldCalib).ok());
+
+  dev.resetCounters();
+  BME280::BME280 warm;
+  ASSERT_TRUE(warm.begin(cfg, blob).ok());
+  ASSERT_FALSE(readsCalibration(dev));
+  Calibration warmCalib;
+  ASSERT_TRUE(warm.getCalibration(warmCalib).ok());
+  ASSERT_EQ(warmCalib.digT1, coldCalib.digT1);
+  ASSERT_EQ(warmCalib.digP9, coldCalib.digP9);
+  ASSERT_EQ(warmCalib.digH2, coldCalib.digH2);
+  ASSERT_EQ(warmCalib.digH6, coldCalib.digH6);
+  // dig_H4/dig_H5 share 0xE5; the sim trim gives 0x13A and 0x032
+  ASSERT_EQ(warmCalib.digH4, 0x13A);
+  ASSERT_EQ(warmCalib.digH5, 0x032);
+  ASSERT_EQ(warmCalib.digH4, coldCalib.digH4);
+  ASSERT_EQ(warmCalib.digH5, coldCalib.digH5);
+  CalibrationBlob again;
+  ASSERT_TRUE(warm.exportCalibration(again).ok());
+  ASSERT_EQ(std::memcmp(again.data, blob.data, CALIBRATION_BLOB_SIZE), 0);
+
+  // Corrupted payload, unknown version, and a blob from another device
+  BME280::BME280 rejected;
+  CalibrationBlob bad = blob;
+  bad.data[5] ^= 0x01;
+  ASSERT_EQ(rejected.begin(cfg, bad).code, Err::CALIBRATION_INVALID);
+  bad = blob;
+  bad.data[0] = 2;
+  resealBlob(bad);
+  const Status version = rejected.begin(cfg, bad);
+  ASSERT_EQ(version.code, Err::CALIBRATION_INVALID);
+  ASSERT_EQ(version.detail, 2);
+  bad = blob;
+  bad.data[1] ^= 0x01;
+  resealBlob(bad);
+  const Status mismatch = rejected.begin(cfg, bad);
+  ASSERT_EQ(mismatch.code, Err::CALIBRATION_INVALID);
+  ASSERT_EQ(mismatch.detail, static_cast<int32_t>(coldCalib.digT1));
+  ASSERT_EQ(rejected.state(), DriverState::UNINIT);
+
+  // Without the spot check the stale blob is trusted
+  cfg.calibSpotCheck = false;
+  ASSERT_TRUE(rejected.begin(cfg, bad).ok());
+}
+
+/// True if every logged access since resetCounters() is part of transaction 1
+static bool singleTransaction(const sim::SimBme280& dev) {
+  for (size_t i = 0; i < dev.accessCount(); ++i) {
+    if (dev.access(i).transaction != 1) {
+      return false;
+    }
+  }
+  return dev.counters().writes + dev.counters().reads == 1;
+}
+
+TEST(sim_config_batch_writes) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+
+  ConfigBatch batch;
+  batch.osrsT = cfg.osrsT;
+  batch.osrsP = cfg.osrsP;
+  batch.osrsH = cfg.osrsH;
+  batch.filter = cfg.filter;
+  batch.standby = cfg.standby;
+  batch.mode = cfg.mode;
+
+  // No-op batch: the shadows match, nothing goes on the bus
+  dev.resetCounters();
+  ASSERT_TRUE(driver.setConfigBatch(batch).ok());
+  ASSERT_EQ(dev.counters().writes, 0u);
+  ASSERT_EQ(dev.counters().reads, 0u);
+
+  // One field: only its register is written
+  dev.resetCounters();
+  batch.filter = Filter::X2;
+  ASSERT_TRUE(driver.setConfigBatch(batch).ok());
+  ASSERT_TRUE(singleTransaction(dev));
+  ASSERT_EQ(dev.accessCount(), size_t{1});
+  ASSERT_EQ(dev.access(0).reg, 0xF5);
+
+  // Every register changes: one pair-list transaction in datasheet order
+  dev.resetCounters();
+  batch.osrsT = Oversampling::X2;
+  batch.osrsH = hasHumidity(COMPILED_CHANNELS) ? Oversampling::X4 : Oversampling::SKIP;
+  batch.filter = Filter::X8;
+  batch.standby = Standby::MS_62_5;
+  batch.mode = Mode::NORMAL;
+  ASSERT_TRUE(driver.setConfigBatch(batch).ok());
+  ASSERT_TRUE(singleTransaction(dev));
+  const size_t pairs = dev.accessCount();
+  ASSERT_TRUE(pairs >= 2);
+  ASSERT_EQ(dev.access(0).reg, 0xF5);
+  ASSERT_EQ(dev.access(pairs - 1).reg, 0xF4);
+  ASSERT_EQ(dev.access(pairs - 1).value & 0x03, 0x03);
+  ASSERT_EQ(dev.reg(0xF5), static_cast<uint8_t>(0x20 | 0x0C));
+  ASSERT_EQ(dev.counters().ignoredConfigWrites, 0u);
+
+  // Repeating it is a no-op again; an individual setter behaves the same way
+  dev.resetCounters();
+  ASSERT_TRUE(driver.setConfigBatch(batch).ok());
+  ASSERT_TRUE(driver.setOversamplingT(Oversampling::X2).ok());
+  ASSERT_EQ(dev.counters().writes, 0u);
+
+  // In NORMAL mode a config change is guarded by SLEEP in the same transaction
+  dev.resetCounters();
+  ASSERT_TRUE(driver.setStandby(Standby::MS_10).ok());
+  ASSERT_TRUE(singleTransaction(dev));
+  ASSERT_EQ(dev.accessCount(), size_t{3});
+  ASSERT_EQ(dev.access(0).reg, 0xF4);
+  ASSERT_EQ(dev.access(0).value & 0x03, 0x00);
+  ASSERT_EQ(dev.access(1).reg, 0xF5);
+  ASSERT_EQ(dev.access(2).reg, 0xF4);
+  ASSERT_EQ(dev.counters().ignoredConfigWrites, 0u);
+}
+
+static size_t statusReads(const sim::SimBme280& dev) {
+  size_t n = 0;
+  for (size_t i = 0; i < dev.accessCount(); ++i) {
+    if (!dev.access(i).write && dev.access(i).reg == 0xF3 && dev.access(i).value == 1) {
+      n++;
+    }
+  }
+  return n;
+}
+
+/// Request and collect samples in NORMAL mode, ticking every millisecond
+static uint32_t runNormal(sim::SimBme280& dev, BME280::BME280& driver, uint32_t samples,
+                          uint32_t& maxGapMs) {
+  uint32_t delivered = 0;
+  uint32_t lastMs = dev.nowMs();
+  maxGapMs = 0;
+  for (uint32_t ms = 0; ms < samples * 200 && delivered < samples; ++ms) {
+    if (!driver.measurementPending() && !driver.measurementReady()) {
+      ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+    }
+    dev.advanceUs(1000);
+    driver.tick(dev.nowMs());
+    CompensatedSample sample;
+    if (driver.getMeasurement(sample).ok()) {
+      const uint32_t gap = dev.nowMs() - lastMs;
+      maxGapMs = (gap > maxGapMs) ? gap : maxGapMs;
+      lastMs = dev.nowMs();
+      delivered++;
+    }
+  }
+  return delivered;
+}
+
+TEST(sim_normal_schedule) {
+  sim::SimBme280 dev;
+  Config cfg;
+  cfg.mode = Mode::NORMAL;
+  cfg.standby = Standby::MS_62_5;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  // One standby period plus the conversion, with the driver's standby slack
+  const uint32_t maxPeriodMs = 2 * 63;
+
+  // Samples come from the schedule alone: no status polls
+  dev.resetCounters();
+  uint32_t maxGapMs = 0;
+  ASSERT_EQ(runNormal(dev, driver, 10, maxGapMs), 10u);
+  ASSERT_EQ(statusReads(dev), size_t{0});
+  ASSERT_EQ(dev.counters().reads, 10u);
+  ASSERT_TRUE(dev.counters().conversions >= 10u);
+  ASSERT_TRUE(maxGapMs <= maxPeriodMs);
+
+  // Same cadence across the 32-bit millisecond wrap of tick(nowMs)
+  sim::SimBme280 late;
+  while (late.nowMs() < 0xFFFFFF00u) {
+    const uint64_t leftUs = (0xFFFFFF00ull - late.nowMs()) * 1000u;
+    late.advanceUs(leftUs > 0xFFFFFFFFull ? 0xFFFFFFFFu : static_cast<uint32_t>(leftUs));
+  }
+  Config wrapCfg = cfg;
+  late.attach(wrapCfg);
+  BME280::BME280 wrapped;
+  ASSERT_TRUE(wrapped.begin(wrapCfg).ok());
+  late.resetCounters();
+  ASSERT_EQ(runNormal(late, wrapped, 10, maxGapMs), 10u);
+  ASSERT_TRUE(late.nowMs() < 0x1000u);
+  ASSERT_TRUE(maxGapMs <= maxPeriodMs);
+  ASSERT_EQ(late.counters().reads, 10u);
+  ASSERT_EQ(statusReads(late), size_t{0});
+}
+
+enum class ResetAccess : uint8_t { NONE, STATUS_POLL, CALIBRATION, CONFIG, OTHER };
+
+/// Classify the accesses one tick() added to the sim log
+static ResetAccess resetAccess(const sim::SimBme280& dev, size_t from) {
+  if (dev.accessCount() == from) {
+    return ResetAccess::NONE;
+  }
+  const sim::SimBme280::Access& a = dev.access(from);
+  if (!a.write && a.reg == 0xF3 && a.value == 1) {
+    return ResetAccess::STATUS_POLL;
+  }
+  if (!a.write && a.reg == 0x88) {
+    return ResetAccess::CALIBRATION;
+  }
+  if (a.write && (a.reg == 0xF2 || a.reg == 0xF4 || a.reg == 0xF5)) {
+    return ResetAccess::CONFIG;
+  }
+  return ResetAccess::OTHER;
+}
+
+TEST(sim_nonblocking_reset) {
+  sim::SimBme280 dev;
+  Config cfg;
+  cfg.filter = Filter::X4;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+
+  // tick() walks NVM wait -> calibration -> config, one step per call
+  dev.resetCounters();
+  ASSERT_EQ(driver.beginReset().code, Err::IN_PROGRESS);
+  ASSERT_EQ(dev.reg(0xF5), 0x00);
+  ASSERT_EQ(driver.requestMeasurement().code, Err::BUSY);
+  ResetAccess steps[32] = {};
+  size_t count = 0;
+  while (driver.resetPending() && count < 32) {
+    dev.advanceUs(1000);
+    const size_t from = dev.accessCount();
+    driver.tick(dev.nowMs());
+    steps[count++] = resetAccess(dev, from);
+  }
+  ASSERT_FALSE(driver.resetPending());
+  ASSERT_TRUE(driver.resetStatus().ok());
+  // The NVM copy takes 2 ms, so at least one poll still sees im_update set
+  ASSERT_TRUE(count >= 4);
+  for (size_t i = 0; i + 2 < count; ++i) {
+    ASSERT_EQ(steps[i], ResetAccess::STATUS_POLL);
+  }
+  ASSERT_EQ(steps[count - 2], ResetAccess::CALIBRATION);
+  ASSERT_EQ(steps[count - 1], ResetAccess::CONFIG);
+  ASSERT_EQ((dev.reg(0xF5) >> 2) & 0x07, static_cast<uint8_t>(Filter::X4));
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+}
+
+TEST(sim_reset_im_update_stuck) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+
+  dev.holdImUpdate(true);
+  dev.resetCounters();
+  ASSERT_EQ(driver.beginReset().code, Err::IN_PROGRESS);
+  for (int i = 0; i < 30 && driver.resetPending(); ++i) {
+    dev.advanceUs(1000);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_FALSE(driver.resetPending());
+  ASSERT_EQ(driver.resetStatus().code, Err::TIMEOUT);
+  ASSERT_EQ(statusReads(dev), dev.counters().reads);
+  ASSERT_TRUE(statusReads(dev) <= 11u);
+
+  // The blocking variant gives up the same way
+  ASSERT_EQ(driver.softReset().code, Err::TIMEOUT);
+
+  // Once the NVM copy finishes a new reset completes
+  dev.holdImUpdate(false);
+  ASSERT_EQ(driver.beginReset().code, Err::IN_PROGRESS);
+  for (int i = 0; i < 30 && driver.resetPending(); ++i) {
+    dev.advanceUs(1000);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_TRUE(driver.resetStatus().ok());
+}
+
+/// Run one async FORCED measurement; service() finishes transfers in the background
+static bool runAsyncForced(sim::SimBme280& dev, sim::SimAsyncI2c& bus, BME280::BME280& driver,
+                           CompensatedSample& out) {
+  if (driver.requestMeasurement().code != Err::IN_PROGRESS) {
+    return false;
+  }
+  for (int i = 0; i < 400 && !driver.measurementReady(); ++i) {
+    dev.advanceUs(50);
+    bus.service();
+    driver.tick(dev.nowMs());
+  }
+  return driver.getMeasurement(out).ok();
+}
+
+TEST(sim_async_transport) {
+  sim::SimBme280 ref;
+  Config refCfg;
+  ref.attach(refCfg);
+  BME280::BME280 sync;
+  ASSERT_TRUE(sync.begin(refCfg).ok());
+  CompensatedSample expected;
+  ASSERT_EQ(sync.requestMeasurement().code, Err::IN_PROGRESS);
+  for (int i = 0; i < 200 && !sync.measurementReady(); ++i) {
+    ref.advanceUs(100);
+    sync.tick(ref.nowMs());
+  }
+  ASSERT_TRUE(sync.getMeasurement(expected).ok());
+
+  for (int usePoll = 0; usePoll < 2; ++usePoll) {
+    sim::SimBme280 dev;
+    sim::SimAsyncI2c bus(dev);
+    Config cfg;
+    bus.attach(cfg, usePoll != 0);
+    BME280::BME280 driver;
+    bus.notify = usePoll ? nullptr : &driver;
+    ASSERT_TRUE(driver.begin(cfg).ok());
+
+    // The trigger is queued, not written: IN_PROGRESS until the shim finishes it
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+    ASSERT_TRUE(driver.transferPending());
+    ASSERT_TRUE(bus.queued());
+    dev.resetCounters();
+    driver.tick(dev.nowMs());
+    ASSERT_TRUE(driver.transferPending());
+    ASSERT_EQ(dev.counters().writes + dev.counters().reads, 0u);
+    dev.advanceUs(bus.latencyUs);
+    bus.service();
+    ASSERT_EQ(dev.counters().writes, 1u);
+    driver.tick(dev.nowMs());
+    ASSERT_FALSE(driver.transferPending());
+
+    for (int i = 0; i < 400 && !driver.measurementReady(); ++i) {
+      dev.advanceUs(50);
+      bus.service();
+      driver.tick(dev.nowMs());
+    }
+    CompensatedSample sample;
+    ASSERT_TRUE(driver.getMeasurement(sample).ok());
+    ASSERT_EQ(sample.tempC_x100, expected.tempC_x100);
+    ASSERT_EQ(sample.pressurePa, expected.pressurePa);
+    ASSERT_EQ(sample.humidityPct_x1024, expected.humidityPct_x1024);
+    // Trigger plus one fused read, both through the shim
+    ASSERT_EQ(bus.completed(), 2u);
+    ASSERT_EQ(bus.polls() > 0, usePoll != 0);
+    ASSERT_EQ(driver.totalFailures(), 0u);
+
+    // A failed async transfer counts against health and is retried
+    bus.failNext(1);
+    const uint32_t submitted = bus.submitted();
+    ASSERT_TRUE(runAsyncForced(dev, bus, driver, sample));
+    ASSERT_EQ(driver.totalFailures(), 1u);
+    ASSERT_EQ(driver.lastError().code, Err::I2C_ERROR);
+    ASSERT_EQ(bus.submitted(), submitted + 3);
+    ASSERT_EQ(driver.consecutiveFailures(), 0u);
+    ASSERT_EQ(driver.state(), DriverState::READY);
+  }
+}
+
+/// SPI framing on the wire: bit 7 set for reads, clear for writes
+static bool spiControlBytesValid(const sim::SimBme280& dev) {
+  for (size_t i = 0; i < dev.accessCount(); ++i) {
+    const sim::SimBme280::Access& a = dev.access(i);
+    if (((a.control & 0x80) != 0) == a.write) {
+      return false;
+    }
+    if ((a.control | 0x80) != a.reg) {
+      return false;
+    }
+  }
+  return dev.counters().badControlBytes == 0;
+}
+
+TEST(sim_spi_transport) {
+  const BusType buses[2] = {BusType::SPI_4WIRE, BusType::SPI_3WIRE};
+  for (size_t b = 0; b < 2; ++b) {
+    sim::SimBme280 dev;
+    Config cfg;
+    cfg.filter = Filter::X2;
+    dev.attachSpi(cfg, buses[b]);
+    BME280::BME280 driver;
+    ASSERT_TRUE(driver.begin(cfg).ok());
+    ASSERT_TRUE(spiControlBytesValid(dev));
+    ASSERT_TRUE(dev.accessCount() > 0);
+    if (buses[b] == BusType::SPI_3WIRE) {
+      // spi3w_en goes out before the first read, which would otherwise float
+      ASSERT_TRUE(dev.access(0).write);
+      ASSERT_EQ(dev.access(0).control, 0x75);
+      ASSERT_EQ(dev.access(0).value & 0x01, 0x01);
+    } else {
+      ASSERT_FALSE(dev.access(0).write);
+      ASSERT_EQ(dev.access(0).control, 0xD0);
+    }
+    // Every config write keeps spi3w_en in the mode the bus needs
+    ASSERT_EQ(dev.reg(0xF5) & 0x01, buses[b] == BusType::SPI_3WIRE ? 0x01 : 0x00);
+
+    dev.resetCounters();
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+    for (int i = 0; i < 200 && !driver.measurementReady(); ++i) {
+      dev.advanceUs(100);
+      driver.tick(dev.nowMs());
+    }
+    CompensatedSample sample;
+    ASSERT_TRUE(driver.getMeasurement(sample).ok());
+    ASSERT_TRUE(absDiffSigned(sample.tempC_x100, 2508) <= 1);
+    ASSERT_TRUE(spiControlBytesValid(dev));
+
+    // A soft reset clears spi3w_en; the reset sequence sets it again
+    ASSERT_TRUE(driver.softReset().ok());
+    ASSERT_EQ(dev.reg(0xF5) & 0x01, buses[b] == BusType::SPI_3WIRE ? 0x01 : 0x00);
+    ASSERT_TRUE(spiControlBytesValid(dev));
+  }
+}
+
+TEST(sim_spi3w_probe_keeps_config) {
+  sim::SimBme280 dev;
+  Config cfg;
+  cfg.filter = Filter::X4;
+  cfg.standby = Standby::MS_250;
+  dev.attachSpi(cfg, BusType::SPI_3WIRE);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  const uint8_t config = dev.reg(0xF5);
+  ASSERT_EQ(config, static_cast<uint8_t>((3 << 5) | (2 << 2) | 0x01));
+
+  // The diagnostic probe is read-only once the driver is configured
+  dev.resetCounters();
+  ASSERT_TRUE(driver.probe().ok());
+  ASSERT_EQ(dev.reg(0xF5), config);
+  ASSERT_EQ(dev.counters().writes, 0u);
+
+  // Re-enabling spi3w_en after a reset writes the configured t_sb and filter too
+  ASSERT_EQ(driver.beginReset().code, Err::IN_PROGRESS);
+  dev.advanceUs(1000);
+  driver.tick(dev.nowMs());
+  ASSERT_EQ(dev.reg(0xF5), config);
+}
+
+TEST(sim_frame_capture_offline) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+
+  constexpr size_t N = 4;
+  const int32_t adc[N][3] = {{415148, 519888, 30000},
+                             {400000, 530000, 28000},
+                             {430000, 505000, 33000},
+                             {410000, 525000, 31000}};
+  auto measure = [&](size_t i) {
+    dev.setAdc(adc[i][0], adc[i][1], adc[i][2]);
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+    for (int k = 0; k < 200 && driver.measurementPending(); ++k) {
+      dev.advanceUs(100);
+      driver.tick(dev.nowMs());
+    }
+  };
+
+  RawFrame frames[N];
+  ASSERT_TRUE(driver.attachFrameBuffer(frames, N).ok());
+  for (size_t i = 0; i < N; ++i) {
+    measure(i);
+    ASSERT_EQ(driver.frameCount(), i + 1);
+    ASSERT_FALSE(driver.measurementReady());
+  }
+  driver.detachFrameBuffer();
+
+  // Frames hold the registers as read; timestamps follow tick()
+  for (size_t i = 0; i < N; ++i) {
+    RawSample raw;
+    comp::decodeFrame(frames[i], raw);
+    ASSERT_EQ(raw.adcP, adc[i][0]);
+    ASSERT_EQ(raw.adcT, adc[i][1]);
+    if (hasHumidity(COMPILED_CHANNELS)) {
+      ASSERT_EQ(raw.adcH, adc[i][2]);
+    }
+    ASSERT_TRUE(i == 0 || frames[i].timestampMs >= frames[i - 1].timestampMs);
+  }
+
+  // Offline recompensation matches what the driver delivers live
+  Calibration calib;
+  ASSERT_TRUE(driver.getCalibration(calib).ok());
+  PreparedCalibration prep;
+  comp::prepareCalibration(calib, prep);
+  CompensatedSample offline[N];
+  ASSERT_TRUE(comp::compensateFrames(prep, frames, offline, N, driver.channels()).ok());
+  for (size_t i = 0; i < N; ++i) {
+    measure(i);
+    CompensatedSample live;
+    ASSERT_TRUE(driver.getMeasurement(live).ok());
+    ASSERT_EQ(offline[i].tempC_x100, live.tempC_x100);
+    ASSERT_EQ(offline[i].pressurePa, live.pressurePa);
+    ASSERT_EQ(offline[i].humidityPct_x1024, live.humidityPct_x1024);
+  }
+}
+
+TEST(sim_forced_auto_rearm) {
+  for (int fused = 0; fused < 2; ++fused) {
+    sim::SimBme280 dev;
+    Config cfg;
+    cfg.forcedAutoRearm = true;
+    cfg.fusedRead = (fused != 0);
+    dev.attach(cfg);
+    BME280::BME280 driver;
+    ASSERT_TRUE(driver.begin(cfg).ok());
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+
+    // One request, then tick() alone keeps the conversions coming
+    dev.resetCounters();
+    uint32_t samples = 0;
+    for (int ms = 0; ms < 100; ++ms) {
+      dev.advanceUs(1000);
+      driver.tick(dev.nowMs());
+      CompensatedSample sample;
+      if (driver.getMeasurement(sample).ok()) {
+        samples++;
+      }
+    }
+    ASSERT_TRUE(samples >= 5);
+    ASSERT_TRUE(dev.counters().conversions >= samples);
+    // The split read still checks the measuring bit once per sample
+    ASSERT_EQ(statusReads(dev), fused ? size_t{0} : static_cast<size_t>(samples));
+
+    // Every data readout is followed directly by the next trigger
+    size_t readouts = 0;
+    for (size_t i = 0; i < dev.accessCount(); ++i) {
+      const sim::SimBme280::Access& a = dev.access(i);
+      if (a.write || a.value == 1) {
+        continue;
+      }
+      readouts++;
+      ASSERT_TRUE(i + 1 < dev.accessCount());
+      const sim::SimBme280::Access& next = dev.access(i + 1);
+      ASSERT_TRUE(next.write);
+      ASSERT_EQ(next.reg, 0xF4);
+      ASSERT_EQ(next.value & 0x03, 0x01);
+      ASSERT_EQ(next.transaction, a.transaction + 1);
+    }
+    ASSERT_EQ(readouts, static_cast<size_t>(samples));
+
+    // With a sample waiting the next conversion is already armed: no new trigger
+    for (int ms = 0; ms < 20 && !driver.measurementReady(); ++ms) {
+      dev.advanceUs(1000);
+      driver.tick(dev.nowMs());
+    }
+    ASSERT_TRUE(driver.measurementReady());
+    dev.resetCounters();
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+    ASSERT_EQ(dev.counters().writes, 0u);
+
+    // Same answer once the sample is consumed and only the conversion is pending
+    CompensatedSample sample;
+    ASSERT_TRUE(driver.getMeasurement(sample).ok());
+    ASSERT_TRUE(driver.measurementPending());
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+    ASSERT_EQ(dev.counters().writes, 0u);
+  }
+}
+
+/// Sim passthrough that fails the next failWrites writes and records, from the
+/// sample callback, whether the next FORCED conversion was already running
+struct RearmProbe {
+  sim::SimBme280* dev = nullptr;
+  uint32_t failWrites = 0;
+  uint32_t callbacks = 0;
+  uint32_t armedInCallback = 0;
+};
+
+static Status probeWrite(uint8_t addr, const uint8_t* data, size_t len, uint32_t timeoutMs,
+                         void* user) {
+  RearmProbe* probe = static_cast<RearmProbe*>(user);
+  if (probe->failWrites > 0) {
+    probe->failWrites--;
+    return Status::Error(Err::I2C_ERROR, "Injected write failure");
+  }
+  return sim::SimBme280::i2cWrite(addr, data, len, timeoutMs, probe->dev);
+}
+
+static Status probeWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                             uint8_t* rxData, size_t rxLen, uint32_t timeoutMs, void* user) {
+  RearmProbe* probe = static_cast<RearmProbe*>(user);
+  return sim::SimBme280::i2cWriteRead(addr, txData, txLen, rxData, rxLen, timeoutMs,
+                                      probe->dev);
+}
+
+static void onRearmProbeSample(const CompensatedSample&, uint32_t, void* user) {
+  RearmProbe* probe = static_cast<RearmProbe*>(user);
+  probe->callbacks++;
+  if ((probe->dev->reg(0xF4) & 0x03) == 0x01) {
+    probe->armedInCallback++;
+  }
+}
+
+TEST(sim_forced_rearm_retries_failed_trigger) {
+  for (int fused = 0; fused < 2; ++fused) {
+    sim::SimBme280 dev;
+    RearmProbe probe;
+    probe.dev = &dev;
+    Config cfg;
+    dev.attach(cfg);
+    cfg.i2cWrite = probeWrite;
+    cfg.i2cWriteRead = probeWriteRead;
+    cfg.i2cUser = &probe;
+    cfg.forcedAutoRearm = true;
+    cfg.fusedRead = (fused != 0);
+    cfg.sampleCallback = onRearmProbeSample;
+    cfg.sampleUser = &probe;
+    BME280::BME280 driver;
+    ASSERT_TRUE(driver.begin(cfg).ok());
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+
+    // The next write is the re-arm after the first readout: it fails once
+    probe.failWrites = 1;
+    for (int ms = 0; ms < 100; ++ms) {
+      dev.advanceUs(1000);
+      driver.tick(dev.nowMs());
+    }
+    ASSERT_EQ(probe.failWrites, 0u);
+    ASSERT_TRUE(driver.state() == DriverState::DEGRADED || driver.state() == DriverState::READY);
+    ASSERT_TRUE(driver.measurementPending() || driver.measurementReady());
+    ASSERT_TRUE(probe.callbacks >= 5u);
+
+    // Apart from the failed one, every re-arm ran before the sample was processed
+    ASSERT_EQ(probe.armedInCallback, probe.callbacks - 1);
+  }
+}
+
+static void countGroupSample(size_t, const CompensatedSample&, uint32_t, void* user) {
+  (*static_cast<uint32_t*>(user))++;
+}
+
+/// Run a Group over devices at 0x76/0x77 sharing one bus for durationMs
+/// @return Delivered samples; overlapTicks counts ticks with both converting
+static uint32_t runGroup(sim::SimBme280 (&devs)[2], uint32_t durationMs,
+                         uint32_t& overlapTicks) {
+  sim::SimBus bus;
+  Group<2> group;
+  uint32_t samples = 0;
+  for (size_t i = 0; i < 2; ++i) {
+    bus.add(devs[i]);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    Config cfg;
+    bus.attach(cfg, devs[i]);
+    if (!group.device(i).begin(cfg).ok()) {
+      return 0;
+    }
+  }
+  group.setCallback(countGroupSample, &samples);
+  if (!group.start(bus.nowMs()).ok()) {
+    return 0;
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    devs[i].resetCounters();
+  }
+
+  overlapTicks = 0;
+  const uint32_t endMs = bus.nowMs() + durationMs;
+  while (bus.nowMs() < endMs) {
+    bus.advanceUs(100);
+    group.tick(bus.nowMs());
+    if ((devs[0].reg(0xF3) & 0x08) != 0 && (devs[1].reg(0xF3) & 0x08) != 0) {
+      overlapTicks++;
+    }
+  }
+  if (group.samplesDelivered() != samples) {
+    return 0;
+  }
+  return samples;
+}
+
+TEST(sim_group_interleaves_two_devices) {
+  // Serial baseline: trigger one device, wait for its sample, then the other
+  sim::SimBme280 serialDevs[2];
+  serialDevs[1].address = 0x77;
+  sim::SimBus serialBus;
+  BME280::BME280 drivers[2];
+  for (size_t i = 0; i < 2; ++i) {
+    serialBus.add(serialDevs[i]);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    Config cfg;
+    serialBus.attach(cfg, serialDevs[i]);
+    ASSERT_TRUE(drivers[i].begin(cfg).ok());
+  }
+  uint32_t serialSamples = 0;
+  const uint32_t serialEndMs = serialBus.nowMs() + 1000;
+  for (size_t i = 0; serialBus.nowMs() < serialEndMs; i ^= 1) {
+    ASSERT_EQ(drivers[i].requestMeasurement().code, Err::IN_PROGRESS);
+    CompensatedSample sample;
+    while (!drivers[i].getMeasurement(sample).ok()) {
+      serialBus.advanceUs(100);
+      drivers[i].tick(serialBus.nowMs());
+    }
+    serialSamples++;
+  }
+
+  // Group: each conversion overlaps the other device's and the rate goes up
+  sim::SimBme280 devs[2];
+  devs[1].address = 0x77;
+  uint32_t overlapTicks = 0;
+  const uint32_t samples = runGroup(devs, 1000, overlapTicks);
+  ASSERT_TRUE(overlapTicks > 0u);
+  ASSERT_TRUE(2 * samples >= 3 * serialSamples);
+  for (size_t i = 0; i < 2; ++i) {
+    ASSERT_EQ(devs[i].counters().nacks, 0u);
+  }
+
+  // Slow parts finish 1 ms after the deadline: a still-converting device is polled
+  // once per millisecond, not on every 100 us tick. About half of the samples come
+  // from each device, so this allows ~6 reads per sample and device, where polling
+  // every tick needs ~10.
+  sim::SimBme280 slowDevs[2];
+  slowDevs[1].address = 0x77;
+  for (size_t i = 0; i < 2; ++i) {
+    slowDevs[i].conversionExtraUs = 4000;
+  }
+  const uint32_t slowSamples = runGroup(slowDevs, 1000, overlapTicks);
+  ASSERT_TRUE(slowSamples > 0u);
+  for (size_t i = 0; i < 2; ++i) {
+    ASSERT_TRUE(slowDevs[i].counters().reads <= 3 * slowSamples);
+  }
+}
+
+/// True if every read since resetCounters() is a 0xF3..0xFE burst
+static bool onlyFusedReads(const sim::SimBme280& dev) {
+  for (size_t i = 0; i < dev.accessCount(); ++i) {
+    const sim::SimBme280::Access& a = dev.access(i);
+    if (!a.write && (a.reg != 0xF3 || a.value != 12)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(sim_fused_read) {
+  sim::SimBme280 dev;
+  Config cfg;
+  cfg.fusedRead = true;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  // Counts only what tick() does; requestMeasurement() checks status once itself
+  auto measure = [&](CompensatedSample& out) {
+    ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+    dev.resetCounters();
+    for (int i = 0; i < 400 && !driver.measurementReady(); ++i) {
+      dev.advanceUs(100);
+      driver.tick(dev.nowMs());
+    }
+    ASSERT_TRUE(driver.getMeasurement(out).ok());
+  };
+
+  // One status + data burst per sample
+  CompensatedSample sample;
+  for (int n = 0; n < 3; ++n) {
+    measure(sample);
+    ASSERT_EQ(dev.counters().reads, 1u);
+    ASSERT_TRUE(onlyFusedReads(dev));
+  }
+  const CompensatedSample reference = sample;
+
+  // A conversion that outlasts the estimate: the measuring bit defers the sample
+  dev.conversionExtraUs = 5000;
+  measure(sample);
+  ASSERT_TRUE(dev.counters().reads > 1u);
+  ASSERT_TRUE(onlyFusedReads(dev));
+  ASSERT_EQ(sample.tempC_x100, reference.tempC_x100);
+  ASSERT_EQ(driver.configDriftCount(), 0u);
+  dev.conversionExtraUs = 0;
+
+  // A brown-out mid-conversion resets the registers: the burst shows the drift,
+  // the data is discarded and the driver rewrites its settings and triggers again
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+  dev.powerOn();
+  dev.resetCounters();
+  for (int i = 0; i < 400 && !driver.measurementReady(); ++i) {
+    dev.advanceUs(100);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_TRUE(driver.getMeasurement(sample).ok());
+  ASSERT_EQ(driver.configDriftCount(), 1u);
+  ASSERT_EQ(dev.counters().conversions, 1u);
+  ASSERT_EQ(sample.tempC_x100, reference.tempC_x100);
+  ASSERT_EQ(sample.pressurePa, reference.pressurePa);
+  ASSERT_EQ(dev.reg(0xF2), static_cast<uint8_t>(cfg.osrsH));
+}
+
+static void windowReference(const CompensatedSample* in, size_t n, WindowSummary& out) {
+  ChannelSummary* channels[3] = {&out.temperature, &out.pressure, &out.humidity};
+  for (size_t c = 0; c < 3; ++c) {
+    double sum = 0.0;
+    int32_t lo = 0;
+    int32_t hi = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const int32_t v = (c == 0) ? in[i].tempC_x100
+                      : (c == 1) ? static_cast<int32_t>(in[i].pressurePa)
+                                 : static_cast<int32_t>(in[i].humidityPct_x1024);
+      sum += v;
+      lo = (i == 0 || v < lo) ? v : lo;
+      hi = (i == 0 || v > hi) ? v : hi;
+    }
+    const double mean = sum / n;
+    double var = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      const int32_t v = (c == 0) ? in[i].tempC_x100
+                      : (c == 1) ? static_cast<int32_t>(in[i].pressurePa)
+                                 : static_cast<int32_t>(in[i].humidityPct_x1024);
+      var += (v - mean) * (v - mean);
+    }
+    channels[c]->min = lo;
+    channels[c]->max = hi;
+    channels[c]->mean = static_cast<int32_t>(std::floor(mean + 0.5));
+    channels[c]->variance = static_cast<uint64_t>(var / n);
+  }
+  out.count = static_cast<uint32_t>(n);
+}
+
+static bool windowMatches(const WindowSummary& a, const WindowSummary& b) {
+  const ChannelSummary* ca[3] = {&a.temperature, &a.pressure, &a.humidity};
+  const ChannelSummary* cb[3] = {&b.temperature, &b.pressure, &b.humidity};
+  for (size_t c = 0; c < 3; ++c) {
+    // The reference variance is in double; allow one unit of rounding
+    const uint64_t dv = (ca[c]->variance > cb[c]->variance) ? ca[c]->variance - cb[c]->variance
+                                                            : cb[c]->variance - ca[c]->variance;
+    if (ca[c]->min != cb[c]->min || ca[c]->max != cb[c]->max || ca[c]->mean != cb[c]->mean ||
+        dv > 1) {
+      return false;
+    }
+  }
+  return a.count == b.count;
+}
+
+TEST(window_stats_tumbling_and_sliding) {
+  static constexpr size_t SAMPLES = 200;
+  static constexpr size_t WINDOW = 16;
+  CompensatedSample in[SAMPLES];
+  uint32_t seed = 12345;
+  for (size_t i = 0; i < SAMPLES; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    in[i].tempC_x100 = -500 + static_cast<int32_t>((seed >> 8) % 4000);
+    in[i].pressurePa = 95000 + (seed >> 4) % 9000;
+    in[i].humidityPct_x1024 = (seed >> 12) % 102400;
+  }
+
+  // 1 sample per 100 ms, 1 s tumbling windows -> 10 samples per window
+  TumblingWindowStats tumbling(1000);
+  SlidingWindowStats<WINDOW> sliding;
+  WindowSummary got;
+  WindowSummary ref;
+  for (size_t i = 0; i < SAMPLES; ++i) {
+    tumbling.add(in[i], static_cast<uint32_t>(i * 100));
+    sliding.add(in[i], static_cast<uint32_t>(i * 100));
+    ASSERT_TRUE(sliding.summary(got));
+    const size_t first = (i + 1 > WINDOW) ? i + 1 - WINDOW : 0;
+    windowReference(&in[first], i + 1 - first, ref);
+    ASSERT_TRUE(windowMatches(got, ref));
+    ASSERT_EQ(got.firstMs, static_cast<uint32_t>(first * 100));
+  }
+
+  ASSERT_EQ(tumbling.windowsClosed(), SAMPLES / 10 - 1);
+  ASSERT_TRUE(tumbling.lastWindow(got));
+  windowReference(&in[SAMPLES - 20], 10, ref);
+  ASSERT_TRUE(windowMatches(got, ref));
+  ASSERT_EQ(got.firstMs, static_cast<uint32_t>((SAMPLES - 20) * 100));
+  ASSERT_EQ(tumbling.count(), 10u);
+
+  // Count-bounded window
+  TumblingWindowStats byCount(0, 4);
+  for (size_t i = 0; i < 8; ++i) {
+    byCount.add(in[i], 0);
+  }
+  ASSERT_EQ(byCount.windowsClosed(), 2u);
+  ASSERT_EQ(byCount.count(), 0u);
+  ASSERT_FALSE(byCount.summary(got));
+}
+
+TEST(sample_filter_median_and_iir) {
+  SampleFilterConfig config;
+  config.temperature.median = MedianTaps::TAPS_3;
+  config.humidity.iirShift = 2;
+  ASSERT_TRUE(config.active());
+  SampleFilter filter;
+  filter.configure(config);
+
+  // A single-sample spike is removed by the 3-tap median
+  const int32_t temps[6] = {2500, 2501, 9000, 2502, 2503, 2504};
+  const int32_t expected[6] = {2500, 2500, 2501, 2502, 2503, 2503};
+  for (size_t i = 0; i < 6; ++i) {
+    CompensatedSample sample;
+    sample.tempC_x100 = temps[i];
+    sample.pressurePa = 100000;
+    sample.humidityPct_x1024 = (i == 0) ? 40960 : 51200;
+    filter.apply(sample);
+    ASSERT_EQ(sample.tempC_x100, expected[i]);
+    ASSERT_EQ(sample.pressurePa, 100000u);  // Pass-through
+  }
+
+  // The IIR approaches a step monotonically and settles on the input
+  uint32_t last = 0;
+  for (int i = 0; i < 100; ++i) {
+    CompensatedSample sample;
+    sample.humidityPct_x1024 = 51200;
+    filter.apply(sample);
+    ASSERT_TRUE(sample.humidityPct_x1024 >= last);
+    last = sample.humidityPct_x1024;
+  }
+  ASSERT_EQ(last, 51200u);
+
+  filter.reset();
+  CompensatedSample seed;
+  seed.humidityPct_x1024 = 1234;
+  filter.apply(seed);
+  ASSERT_EQ(seed.humidityPct_x1024, 1234u);
+
+  // Out-of-range pressure (>= 2^23) passes through the IIR without overflow
+  config.pressure.iirShift = SAMPLE_IIR_MAX_SHIFT;
+  filter.configure(config);
+  const uint32_t huge[3] = {0x7FFFFFF0u, 0x7FFFFFF0u, 0x40000000u};
+  uint32_t prev = 0;
+  for (int i = 0; i < 3; ++i) {
+    CompensatedSample sample;
+    sample.pressurePa = huge[i];
+    filter.apply(sample);
+    ASSERT_TRUE(i == 0 || sample.pressurePa <= prev);
+    ASSERT_TRUE(sample.pressurePa >= 0x40000000u && sample.pressurePa <= 0x7FFFFFF0u);
+    prev = sample.pressurePa;
+  }
+  ASSERT_EQ(prev, 0x7FFFFFF0u - ((0x7FFFFFF0u - 0x40000000u + 127u) >> 7));
+}
+
+TEST(frame_processor_matches_live_path) {
+  SampleFilterConfig filter;
+  filter.temperature.iirShift = 2;
+  filter.pressure.median = MedianTaps::TAPS_3;
+  filter.humidity.iirShift = 1;
+  static constexpr size_t SAMPLES = 20;
+
+  // Live path: tick() compensates and filters into a sample ring
+  sim::SimBme280 liveDev;
+  Config cfg;
+  cfg.sampleFilter = filter;
+  liveDev.attach(cfg);
+  BME280::BME280 live;
+  ASSERT_TRUE(live.begin(cfg).ok());
+  static SampleRing<32> liveRing;
+  ASSERT_TRUE(live.attachSampleRing(&liveRing).ok());
+
+  // Raw path: the same conversions captured as frames
+  sim::SimBme280 rawDev;
+  rawDev.attach(cfg);
+  BME280::BME280 raw;
+  ASSERT_TRUE(raw.begin(cfg).ok());
+  static FrameRing<32> frames;
+  ASSERT_TRUE(raw.attachFrameRing(&frames).ok());
+
+  for (size_t k = 0; k < SAMPLES; ++k) {
+    const int32_t step = static_cast<int32_t>(k);
+    liveDev.setAdc(415148 + (step % 3) * 4000, 519888 + step * 500, 30000 + step * 100);
+    rawDev.setAdc(415148 + (step % 3) * 4000, 519888 + step * 500, 30000 + step * 100);
+    ASSERT_EQ(live.requestMeasurement().code, Err::IN_PROGRESS);
+    ASSERT_EQ(raw.requestMeasurement().code, Err::IN_PROGRESS);
+    for (int i = 0; i < 200 && (liveRing.size() <= k || frames.size() <= k); ++i) {
+      liveDev.advanceUs(100);
+      rawDev.advanceUs(100);
+      live.tick(liveDev.nowMs());
+      raw.tick(rawDev.nowMs());
+    }
+    ASSERT_EQ(liveRing.size(), k + 1);
+    ASSERT_EQ(frames.size(), k + 1);
+  }
+
+  Calibration calib;
+  ASSERT_TRUE(raw.getCalibration(calib).ok());
+  FrameProcessor processor;
+  processor.configure(calib, raw.channels(), raw.sampleFilter());
+  DerivedConfig derivedCfg;
+  derivedCfg.stationAltitudeCm = 12000;
+  processor.setDerivedConfig(derivedCfg);
+
+  // At most BATCH frames per call; the filter state carries across calls
+  TimestampedSample out[SAMPLES];
+  DerivedSample derived[SAMPLES];
+  const size_t first = processor.process(frames, out, derived, SAMPLES);
+  ASSERT_EQ(first, FrameProcessor::BATCH);
+  const size_t second = processor.process(frames, &out[first], &derived[first], SAMPLES - first);
+  ASSERT_EQ(first + second, SAMPLES);
+  ASSERT_EQ(processor.process(frames, out, nullptr, SAMPLES), size_t{0});
+  ASSERT_EQ(processor.errors(), 0u);
+
+  for (size_t i = 0; i < SAMPLES; ++i) {
+    TimestampedSample expected;
+    ASSERT_TRUE(liveRing.pop(expected));
+    ASSERT_EQ(out[i].timestampMs, expected.timestampMs);
+    ASSERT_EQ(out[i].sample.tempC_x100, expected.sample.tempC_x100);
+    ASSERT_EQ(out[i].sample.pressurePa, expected.sample.pressurePa);
+    ASSERT_EQ(out[i].sample.humidityPct_x1024, expected.sample.humidityPct_x1024);
+
+    DerivedSample single;
+    derived::derive(out[i].sample, single, derivedCfg);
+    ASSERT_EQ(derived[i].altitudeCm, single.altitudeCm);
+    ASSERT_EQ(derived[i].seaLevelPa, single.seaLevelPa);
+    ASSERT_EQ(derived[i].dewPointC_x100, single.dewPointC_x100);
+    ASSERT_EQ(derived[i].absHumidity_mgm3, single.absHumidity_mgm3);
+  }
+}
+
+TEST(adaptive_oversampling_converges) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+
+  AdaptiveOversamplingConfig config;
+  config.pressure.targetNoise = 5;  // Pa
+  config.blockSamples = 128;
+  AdaptiveOversampling controller(config);
+
+  // Synthetic pressure noise: 12 Pa std dev at X1, variance halving per setting
+  static const int32_t NOISE_MPA[5] = {12000, 8485, 6000, 4243, 3000};
+  uint32_t seed = 1;
+  auto feed = [&](int samples) {
+    for (int i = 0; i < samples; ++i) {
+      Oversampling osrs = Oversampling::X1;
+      driver.getOversamplingP(osrs);
+      int32_t sum = 0;  // Sum of 4 uniforms in [-512, 512): std dev 591
+      for (int k = 0; k < 4; ++k) {
+        seed = seed * 1103515245u + 12345u;
+        sum += static_cast<int32_t>((seed >> 16) & 0x3FF) - 512;
+      }
+      const int32_t noise = sum * NOISE_MPA[static_cast<int>(osrs) - 1] / 591000;
+      CompensatedSample sample;
+      sample.tempC_x100 = 2500;
+      sample.pressurePa = static_cast<uint32_t>(100000 + noise);
+      sample.humidityPct_x1024 = 40960;
+      ASSERT_TRUE(controller.update(driver, sample).ok());
+    }
+  };
+
+  // X1 -> X2 -> X4 -> X8 (18 Pa^2 <= 25 Pa^2, X4 at 36 Pa^2 would exceed)
+  feed(10 * 128);
+  Oversampling osrs = Oversampling::X1;
+  ASSERT_TRUE(driver.getOversamplingP(osrs).ok());
+  ASSERT_EQ(osrs, Oversampling::X8);
+  ASSERT_EQ(controller.adjustments(), 3u);
+  ASSERT_TRUE(controller.lastEstimate().pressure <= 25u);
+  ASSERT_TRUE(driver.getOversamplingT(osrs).ok());
+  ASSERT_EQ(osrs, Oversampling::X1);  // Not controlled
+
+  // A looser target steps back down to the lower bound
+  config.pressure.targetNoise = 40;
+  config.pressure.min = Oversampling::X2;
+  controller.configure(config);
+  feed(10 * 128);
+  ASSERT_TRUE(driver.getOversamplingP(osrs).ok());
+  ASSERT_EQ(osrs, Oversampling::X2);
+
+  // Settings outside the bounds are clamped by the first update
+  ASSERT_TRUE(driver.setOversamplingP(Oversampling::X16).ok());
+  ASSERT_TRUE(driver.setOversamplingT(Oversampling::X1).ok());
+  config.pressure.max = Oversampling::X4;
+  config.temperature.targetNoise = 10;
+  config.temperature.min = Oversampling::X2;
+  controller.configure(config);
+  const uint32_t adjustments = controller.adjustments();
+  feed(1);
+  ASSERT_TRUE(driver.getOversamplingP(osrs).ok());
+  ASSERT_EQ(osrs, Oversampling::X4);
+  ASSERT_TRUE(driver.getOversamplingT(osrs).ok());
+  ASSERT_EQ(osrs, Oversampling::X2);
+  ASSERT_EQ(controller.adjustments(), adjustments);
+}
+
+static void onDeliveredSample(const CompensatedSample& sample, uint32_t nowMs, void* user) {
+  (void)sample;
+  (void)nowMs;
+  (*static_cast<uint32_t*>(user))++;
+}
+
+TEST(deadband_suppresses_unchanged_samples) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  uint32_t delivered = 0;
+  cfg.forcedAutoRearm = true;
+  cfg.sampleCallback = onDeliveredSample;
+  cfg.sampleUser = &delivered;
+  cfg.deadband.tempC_x100 = 50;
+  cfg.deadband.maxSilenceMs = 1000;
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  TumblingWindowStats window(0, WINDOW_MAX_SAMPLES);
+  ASSERT_TRUE(driver.attachWindowStats(&window).ok());
+
+  // 500 ms of continuous FORCED conversions with constant ADC values
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+  const uint32_t endMs = dev.nowMs() + 500;
+  while (dev.nowMs() < endMs) {
+    dev.advanceUs(100);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_EQ(delivered, 1u);
+  ASSERT_TRUE(window.count() > 10u);
+  ASSERT_EQ(driver.suppressedSamples(), window.count() - 1);
+
+  // A temperature step beyond the band is delivered once
+  dev.setAdc(415148, 529888, 30000);
+  for (int i = 0; i < 200; ++i) {
+    dev.advanceUs(100);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_EQ(delivered, 2u);
+
+  // The heartbeat delivers after maxSilenceMs without a change
+  for (int i = 0; i < 11000; ++i) {
+    dev.advanceUs(100);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_EQ(delivered, 3u);
+}
+
+#if BME280_ENABLE_INSTRUMENTATION
+TEST(instrumentation_counts_and_trace) {
+  ASSERT_EQ(latencyBucket(0), 0u);
+  ASSERT_EQ(latencyBucket(50), 1u);
+  ASSERT_EQ(latencyBucket(100000), LATENCY_BUCKET_COUNT - 1);
+
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  driver.resetBusStats();
+  dev.resetCounters();
+
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+  for (int i = 0; i < 200 && !driver.measurementReady(); ++i) {
+    dev.advanceUs(100);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_TRUE(driver.measurementReady());
+
+  const BusStats& stats = driver.busStats();
+  ASSERT_EQ(stats.ops[static_cast<size_t>(BusOp::TRIGGER)].count, 1u);
+  ASSERT_EQ(stats.ops[static_cast<size_t>(BusOp::DATA_READ)].count, 1u);
+  // The data burst covers only the enabled channels, plus the register address byte
+  const Channels ch = driver.channels();
+  const size_t first = hasPressure(ch) ? cmd::DATA_IDX_PRESS : cmd::DATA_IDX_TEMP;
+  const size_t end = hasHumidity(ch) ? cmd::DATA_LEN : cmd::DATA_IDX_HUM;
+  ASSERT_EQ(stats.ops[static_cast<size_t>(BusOp::DATA_READ)].bytes, 1u + (end - first));
+  ASSERT_TRUE(stats.ops[static_cast<size_t>(BusOp::STATUS_POLL)].count >= 1u);
+
+  uint32_t total = 0;
+  uint32_t histogram = 0;
+  for (size_t i = 0; i < BUS_OP_COUNT; ++i) {
+    total += stats.ops[i].count;
+  }
+  for (size_t i = 0; i < LATENCY_BUCKET_COUNT; ++i) {
+    histogram += stats.latencyHistogram[i];
+  }
+  ASSERT_EQ(histogram, total);
+  ASSERT_EQ(total, dev.counters().reads + dev.counters().writes);
+
+  BusTraceEntry trace[BME280_TRACE_DEPTH];
+  const size_t n = driver.busTrace(trace, BME280_TRACE_DEPTH);
+  ASSERT_TRUE(n >= 3);
+  // Idle check, trigger, ..., data read
+  ASSERT_EQ(trace[0].op, BusOp::STATUS_POLL);
+  ASSERT_EQ(trace[1].op, BusOp::TRIGGER);
+  ASSERT_EQ(trace[1].reg, cmd::REG_CTRL_MEAS);
+  ASSERT_EQ(trace[n - 1].op, BusOp::DATA_READ);
+  ASSERT_EQ(trace[n - 1].reg, cmd::REG_DATA_START);
+
+#if BME280_ENABLE_DIAGNOSTICS
+  dev.injectNacks(1);
+  uint8_t id = 0;
+  ASSERT_FALSE(driver.readChipId(id).ok());
+  ASSERT_EQ(driver.busStats().ops[static_cast<size_t>(BusOp::REGISTER_READ)].failures, 1u);
+  ASSERT_EQ(driver.busTrace(trace, 1), 1u);
+  ASSERT_EQ(trace[0].code, Err::I2C_ERROR);
+#endif
+}
+#endif
+
+TEST(ring_drop_newest) {
+  StaticSpscRing<uint32_t, 4> ring;
+  for (uint32_t i = 0; i < 6; ++i) {
+    ring.push(i);
+  }
+  ASSERT_EQ(ring.size(), 4u);
+  ASSERT_EQ(ring.overruns(), 2u);
+  uint32_t v = 0;
+  ASSERT_TRUE(ring.pop(v));
+  ASSERT_EQ(v, 0u);
+}
+
+TEST(ring_overwrite_oldest) {
+  SampleRing<4> ring(RingPolicy::OVERWRITE_OLDEST);
+  for (uint32_t i = 0; i < 6; ++i) {
+    TimestampedSample item;
+    item.timestampMs = i;
+    ASSERT_TRUE(ring.push(item));
+  }
+  ASSERT_EQ(ring.size(), 4u);
+  ASSERT_EQ(ring.overruns(), 2u);
+  TimestampedSample out;
+  ASSERT_TRUE(ring.pop(out));
+  ASSERT_EQ(out.timestampMs, 2u);
+  while (ring.pop(out)) {
+  }
+  ASSERT_EQ(out.timestampMs, 5u);
+  ASSERT_TRUE(ring.empty());
+}
+
+TEST(sample_codec_roundtrip) {
+  uint8_t buffer[256];
+  SampleEncoder enc(buffer, sizeof(buffer));
+  CompensatedSample sample;
+  ASSERT_EQ(enc.encode(sample, 0).code, Err::NOT_INITIALIZED);
+  SampleStreamHeader header;
+  header.calibrationId = 0xBEEF;
+  ASSERT_TRUE(enc.begin(header).ok());
+  ASSERT_EQ(enc.size(), SAMPLE_CODEC_HEADER_SIZE);
+
+  // Stable environment at 1 Hz: 4 bytes per TPH sample once the step is known
+  const bool withP = hasPressure(COMPILED_CHANNELS);
+  const bool withH = hasHumidity(COMPILED_CHANNELS);
+  const size_t stableRecord = 2u + (withP ? 1u : 0u) + (withH ? 1u : 0u);
+  CompensatedSample in[12];
+  uint32_t inMs[12];
+  for (int i = 0; i < 10; ++i) {
+    in[i].tempC_x100 = 2150 + (i % 3) - 1;
+    in[i].pressurePa = 101325 + static_cast<uint32_t>(i % 2);
+    in[i].humidityPct_x1024 = 45000 - static_cast<uint32_t>(i % 4);
+    inMs[i] = 123456 + 1000 * static_cast<uint32_t>(i);
+  }
+  // Extremes and a timestamp wrap still round-trip
+  in[10].tempC_x100 = -4000;
+  in[10].pressurePa = 0;
+  in[10].humidityPct_x1024 = 102400;
+  inMs[10] = 0xFFFFFF00u;
+  in[11].tempC_x100 = 8500;
+  in[11].pressurePa = 0xFFFFFFFFu;
+  in[11].humidityPct_x1024 = 0;
+  inMs[11] = 0x10;
+  size_t stableBytes = 0;
+  for (int i = 0; i < 12; ++i) {
+    const size_t before = enc.size();
+    ASSERT_TRUE(enc.encode(in[i], inMs[i]).ok());
+    if (i >= 2 && i < 10) {
+      ASSERT_TRUE(enc.size() - before <= stableRecord);
+      stableBytes += enc.size() - before;
+    }
+  }
+  ASSERT_EQ(stableBytes, 8u * stableRecord);
+
+  SampleDecoder dec(enc.data(), enc.size());
+  CompensatedSample out;
+  uint32_t outMs = 0;
+  ASSERT_FALSE(dec.next(out, outMs));
+  SampleStreamHeader parsed;
+  ASSERT_TRUE(dec.readHeader(parsed).ok());
+  ASSERT_EQ(parsed.calibrationId, 0xBEEF);
+  ASSERT_EQ(parsed.channels, COMPILED_CHANNELS);
+  for (int i = 0; i < 12; ++i) {
+    ASSERT_TRUE(dec.next(out, outMs));
+    ASSERT_EQ(outMs, inMs[i]);
+    ASSERT_EQ(out.tempC_x100, in[i].tempC_x100);
+    ASSERT_EQ(out.pressurePa, withP ? in[i].pressurePa : 0u);
+    ASSERT_EQ(out.humidityPct_x1024, withH ? in[i].humidityPct_x1024 : 0u);
+  }
+  ASSERT_FALSE(dec.next(out, outMs));
+  ASSERT_FALSE(dec.truncated());
+
+  // A cut record is reported, not decoded
+  SampleDecoder cut(enc.data(), enc.size() - 1);
+  ASSERT_TRUE(cut.readHeader(parsed).ok());
+  int decoded = 0;
+  while (cut.next(out, outMs)) {
+    decoded++;
+  }
+  ASSERT_EQ(decoded, 11);
+  ASSERT_TRUE(cut.truncated());
+
+  // Temperature-only stream, flushed through a small buffer
+  uint8_t small[18];
+  SampleEncoder tOnly(small, sizeof(small));
+  header.channels = Channels::T;
+  ASSERT_TRUE(tOnly.begin(header).ok());
+  ASSERT_TRUE(tOnly.encode(in[0], 1000).ok());  // 2 + 2 bytes
+  ASSERT_TRUE(tOnly.encode(in[1], 2000).ok());  // 2 + 1 bytes
+  ASSERT_TRUE(tOnly.encode(in[2], 3000).ok());  // 1 + 1 bytes
+  ASSERT_EQ(tOnly.size(), SAMPLE_CODEC_HEADER_SIZE + 9);
+  // Full encoders leave the buffer unchanged
+  const size_t full = tOnly.size();
+  ASSERT_EQ(tOnly.encode(in[10], inMs[10]).code, Err::BUSY);
+  ASSERT_EQ(tOnly.size(), full);
+}
+
+// Same bytes as GOLDEN_STREAM in test/host/test_decode_samples.py
+static const uint8_t GOLDEN_STREAM[] = {
+  0x42, 0x53, 0x01, 0x07, 0x00, 0x3C, 0x5A, 0xC0, 0xA9, 0x07, 0x98, 0x27,
+  0x9A, 0xAF, 0x0C, 0x80, 0xE0, 0x05, 0xD0, 0x0F, 0x02, 0x04, 0x07, 0x00,
+  0x03, 0x05, 0x0C, 0x14, 0xC1, 0x29, 0xDB, 0x16, 0xFC, 0xDF, 0x06,
+};
+static const CompensatedSample GOLDEN_SAMPLES[4] = {
+  {2508, 101325, 47104}, {2509, 101327, 47100}, {2507, 101324, 47106}, {-150, 99870, 102400}};
+static const uint32_t GOLDEN_TIMES_MS[4] = {60000, 61000, 62000, 63010};
+
+TEST(sample_codec_golden_stream) {
+  // Decoding follows the stream header, whatever channels this build has
+  SampleDecoder dec(GOLDEN_STREAM, sizeof(GOLDEN_STREAM));
+  SampleStreamHeader parsed;
+  ASSERT_TRUE(dec.readHeader(parsed).ok());
+  ASSERT_EQ(parsed.channels, Channels::TPH);
+  CompensatedSample out;
+  uint32_t outMs = 0;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(dec.next(out, outMs));
+    ASSERT_EQ(outMs, GOLDEN_TIMES_MS[i]);
+    ASSERT_EQ(out.tempC_x100, GOLDEN_SAMPLES[i].tempC_x100);
+    ASSERT_EQ(out.pressurePa, GOLDEN_SAMPLES[i].pressurePa);
+    ASSERT_EQ(out.humidityPct_x1024, GOLDEN_SAMPLES[i].humidityPct_x1024);
+  }
+  ASSERT_FALSE(dec.next(out, outMs));
+
+  uint8_t buffer[64];
+  SampleEncoder enc(buffer, sizeof(buffer));
+  SampleStreamHeader header;
+  header.calibrationId = 0x5A3C;
+  ASSERT_TRUE(enc.begin(header).ok());
+  // The header only claims the channels the encoder writes
+  ASSERT_EQ(buffer[3], static_cast<uint8_t>(COMPILED_CHANNELS));
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(enc.encode(GOLDEN_SAMPLES[i], GOLDEN_TIMES_MS[i]).ok());
+  }
+#if BME280_ENABLE_PRESSURE && BME280_ENABLE_HUMIDITY
+  ASSERT_EQ(enc.size(), sizeof(GOLDEN_STREAM));
+  for (size_t i = 0; i < sizeof(GOLDEN_STREAM); ++i) {
+    ASSERT_EQ(enc.data()[i], GOLDEN_STREAM[i]);
+  }
+#else
+  // A stripped build frames its own stream correctly
+  SampleDecoder own(enc.data(), enc.size());
+  ASSERT_TRUE(own.readHeader(parsed).ok());
+  ASSERT_EQ(parsed.channels, COMPILED_CHANNELS);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(own.next(out, outMs));
+    ASSERT_EQ(outMs, GOLDEN_TIMES_MS[i]);
+    ASSERT_EQ(out.tempC_x100, GOLDEN_SAMPLES[i].tempC_x100);
+    ASSERT_EQ(out.pressurePa, BME280_ENABLE_PRESSURE ? GOLDEN_SAMPLES[i].pressurePa : 0u);
+    ASSERT_EQ(out.humidityPct_x1024,
+              BME280_ENABLE_HUMIDITY ? GOLDEN_SAMPLES[i].humidityPct_x1024 : 0u);
+  }
+  ASSERT_FALSE(own.next(out, outMs));
+  ASSERT_FALSE(own.truncated());
+#endif
+}
+
+TEST(auto_recovery_backoff) {
+  sim::SimBme280 dev;
+  Config cfg;
+  dev.attach(cfg);
+  cfg.osrsT = Oversampling::X2;
+  cfg.offlineThreshold = 2;
+  cfg.recovery.enabled = true;
+  cfg.recovery.initialMs = 100;
+  cfg.recovery.maxMs = 400;
+  cfg.recovery.jitterPct = 0;
+  BME280::BME280 driver;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  const uint8_t ctrlMeas = dev.reg(cmd::REG_CTRL_MEAS);
+  ASSERT_TRUE(ctrlMeas != 0);
+
+  // Unplugged: two failed requests take the driver OFFLINE
+  dev.injectNacks(1000000);
+  ASSERT_EQ(driver.requestMeasurement().code, Err::I2C_ERROR);
+  ASSERT_EQ(driver.requestMeasurement().code, Err::I2C_ERROR);
+  ASSERT_EQ(driver.state(), DriverState::OFFLINE);
+  const uint32_t failures = driver.totalFailures();
+
+  // Probes at +100, +300, +700, +1100 and +1500 ms (doubling, capped at 400)
+  const uint32_t startMs = dev.nowMs();
+  driver.tick(startMs);
+  ASSERT_TRUE(driver.recoveryScheduled());
+  ASSERT_EQ(driver.nextRecoveryMs(), startMs + 100);
+  while (dev.nowMs() < startMs + 1600) {
+    dev.advanceUs(1000);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_EQ(driver.recoveryAttempts(), 5u);
+  ASSERT_EQ(driver.nextRecoveryMs(), startMs + 1900);
+  ASSERT_EQ(driver.totalFailures(), failures);  // Probes are not health-tracked
+  ASSERT_EQ(driver.requestMeasurement().code, Err::BUSY);
+
+  // Power-cycled and reconnected: the next probe writes the configuration again
+  dev.injectNacks(0);
+  dev.powerOn();
+  ASSERT_EQ(dev.reg(cmd::REG_CTRL_MEAS), 0);
+  while (driver.state() == DriverState::OFFLINE && dev.nowMs() < startMs + 3000) {
+    dev.advanceUs(1000);
+    driver.tick(dev.nowMs());
+  }
+  ASSERT_EQ(driver.state(), DriverState::READY);
+  ASSERT_EQ(driver.recoveryAttempts(), 6u);
+  ASSERT_EQ(driver.recoveries(), 1u);
+  ASSERT_FALSE(driver.recoveryScheduled());
+  ASSERT_EQ(dev.reg(cmd::REG_CTRL_MEAS), ctrlMeas);
+  ASSERT_EQ(driver.requestMeasurement().code, Err::IN_PROGRESS);
+
+  // Jitter spreads the first delay over 100 +/- 50 %
+  cfg.recovery.jitterPct = 50;
+  cfg.recovery.maxMs = RECOVERY_MAX_BACKOFF_MS + 1;
+  ASSERT_EQ(driver.begin(cfg).code, Err::INVALID_CONFIG);
+  cfg.recovery.maxMs = 400;
+  ASSERT_TRUE(driver.begin(cfg).ok());
+  dev.injectNacks(2);
+  driver.requestMeasurement();
+  driver.requestMeasurement();
+  ASSERT_EQ(driver.state(), DriverState::OFFLINE);
+  driver.tick(dev.nowMs());
+  const uint32_t delayMs = driver.nextRecoveryMs() - dev.nowMs();
+  ASSERT_TRUE(delayMs >= 50 && delayMs <= 150);
 }
 
 // ============================================================================
@@ -89,7 +1860,44 @@ int main() {
   RUN_TEST(status_ok);
   RUN_TEST(status_error);
   RUN_TEST(status_in_progress);
+  RUN_TEST(status_profile);
   RUN_TEST(config_defaults);
+  RUN_TEST(compensation_int64_reference);
+  RUN_TEST(compensation_int32_matches_int64);
+  RUN_TEST(compensation_float_within_tolerance);
+  RUN_TEST(compensation_batch_matches_single);
+  RUN_TEST(compensation_skipped_channels);
+  RUN_TEST(derived_reference_values);
+  RUN_TEST(derived_batch_matches_single);
+  RUN_TEST(sim_forced_measurement);
+  RUN_TEST(sim_forced_settings_restart);
+  RUN_TEST(sim_forced_long_stall);
+  RUN_TEST(sim_calibration_warm_boot);
+  RUN_TEST(sim_config_batch_writes);
+  RUN_TEST(sim_normal_schedule);
+  RUN_TEST(sim_nonblocking_reset);
+  RUN_TEST(sim_reset_im_update_stuck);
+  RUN_TEST(sim_async_transport);
+  RUN_TEST(sim_spi_transport);
+  RUN_TEST(sim_spi3w_probe_keeps_config);
+  RUN_TEST(sim_frame_capture_offline);
+  RUN_TEST(sim_forced_auto_rearm);
+  RUN_TEST(sim_forced_rearm_retries_failed_trigger);
+  RUN_TEST(sim_group_interleaves_two_devices);
+  RUN_TEST(sim_fused_read);
+  RUN_TEST(window_stats_tumbling_and_sliding);
+  RUN_TEST(sample_filter_median_and_iir);
+  RUN_TEST(frame_processor_matches_live_path);
+  RUN_TEST(deadband_suppresses_unchanged_samples);
+  RUN_TEST(adaptive_oversampling_converges);
+#if BME280_ENABLE_INSTRUMENTATION
+  RUN_TEST(instrumentation_counts_and_trace);
+#endif
+  RUN_TEST(ring_drop_newest);
+  RUN_TEST(ring_overwrite_oldest);
+  RUN_TEST(sample_codec_roundtrip);
+  RUN_TEST(sample_codec_golden_stream);
+  RUN_TEST(auto_recovery_backoff);
   
   printf("\n=== Results: %d passed, %d failed ===\n\n", testsPassed, testsFailed);
   
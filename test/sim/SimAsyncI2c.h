@@ -0,0 +1,114 @@
+/// @file SimAsyncI2c.h
+/// @brief Asynchronous I2C shim over SimBme280 for host-native tests
+/// @note NOT part of the library - tests only
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/BME280.h"
+#include "SimBme280.h"
+
+namespace sim {
+
+/// Queues one Config::i2cSubmit transfer and runs it on the simulator once
+/// latencyUs has elapsed and service() is called, like a DMA engine finishing
+/// in the background. Completion is reported through Config::i2cPoll or, with
+/// notify set, through BME280::onTransferComplete(). Blocking transfers pass
+/// straight through to the simulator.
+class SimAsyncI2c {
+public:
+  explicit SimAsyncI2c(SimBme280& dev) : _dev(dev) {}
+
+  uint32_t latencyUs = 200;            ///< Time from submit to completion
+  BME280::BME280* notify = nullptr;    ///< Report via onTransferComplete() instead of poll
+
+  /// Wire the simulator plus the async callbacks into a driver Config
+  void attach(BME280::Config& cfg, bool usePoll) {
+    _dev.attach(cfg);
+    cfg.i2cWrite = &SimAsyncI2c::i2cWrite;
+    cfg.i2cWriteRead = &SimAsyncI2c::i2cWriteRead;
+    cfg.i2cSubmit = &SimAsyncI2c::submit;
+    cfg.i2cPoll = usePoll ? &SimAsyncI2c::poll : nullptr;
+    cfg.i2cUser = this;
+  }
+
+  /// Fail the next count asynchronous transfers with I2C_ERROR
+  void failNext(uint32_t count) { _failNext = count; }
+
+  /// Finish the queued transfer if its latency has elapsed
+  void service() {
+    if (!_queued || _dev.nowUs() < _doneAtUs) {
+      return;
+    }
+    _queued = false;
+    if (_failNext > 0) {
+      _failNext--;
+      _result = Status::Error(Err::I2C_ERROR, "Async transfer failed", 4);
+    } else if (_xfer.rxLen > 0) {
+      _result = SimBme280::i2cWriteRead(_xfer.addr, _xfer.txData, _xfer.txLen, _xfer.rxData,
+                                        _xfer.rxLen, _xfer.timeoutMs, &_dev);
+    } else {
+      _result = SimBme280::i2cWrite(_xfer.addr, _xfer.txData, _xfer.txLen, _xfer.timeoutMs,
+                                    &_dev);
+    }
+    _completed++;
+    if (notify != nullptr) {
+      notify->onTransferComplete(_result);
+    } else {
+      _done = true;
+    }
+  }
+
+  bool queued() const { return _queued; }
+  uint32_t submitted() const { return _submitted; }
+  uint32_t completed() const { return _completed; }
+  uint32_t polls() const { return _polls; }
+
+  static Status i2cWrite(uint8_t addr, const uint8_t* data, size_t len,
+                         uint32_t timeoutMs, void* user) {
+    return SimBme280::i2cWrite(addr, data, len, timeoutMs, &static_cast<SimAsyncI2c*>(user)->_dev);
+  }
+
+  static Status i2cWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                             uint8_t* rxData, size_t rxLen, uint32_t timeoutMs, void* user) {
+    return SimBme280::i2cWriteRead(addr, txData, txLen, rxData, rxLen, timeoutMs,
+                                   &static_cast<SimAsyncI2c*>(user)->_dev);
+  }
+
+  static Status submit(const BME280::I2cTransfer& xfer, void* user) {
+    SimAsyncI2c* self = static_cast<SimAsyncI2c*>(user);
+    if (self->_queued) {
+      return Status::Error(Err::BUSY, "Shim busy");
+    }
+    self->_xfer = xfer;
+    self->_queued = true;
+    self->_done = false;
+    self->_doneAtUs = self->_dev.nowUs() + self->latencyUs;
+    self->_submitted++;
+    return Status::Error(Err::IN_PROGRESS, "Queued");
+  }
+
+  static Status poll(void* user) {
+    SimAsyncI2c* self = static_cast<SimAsyncI2c*>(user);
+    self->_polls++;
+    if (!self->_done) {
+      return Status::Error(Err::IN_PROGRESS, "Running");
+    }
+    self->_done = false;
+    return self->_result;
+  }
+
+private:
+  SimBme280& _dev;
+  BME280::I2cTransfer _xfer;
+  Status _result = Status::Ok();
+  uint64_t _doneAtUs = 0;
+  uint32_t _failNext = 0;
+  uint32_t _submitted = 0;
+  uint32_t _completed = 0;
+  uint32_t _polls = 0;
+  bool _queued = false;
+  bool _done = false;
+};
+
+}  // namespace sim
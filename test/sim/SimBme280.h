@@ -0,0 +1,465 @@
+/// @file SimBme280.h
+/// @brief Register-level BME280 simulator for host-native tests and benchmarks
+/// @note NOT part of the library - tests only
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "BME280/Config.h"
+#include "BME280/Status.h"
+
+namespace sim {
+
+using BME280::Err;
+using BME280::Status;
+
+/// Simulated BME280 on an I2C or SPI bus
+///
+/// Models the register map, calibration NVM, soft reset with im_update, ctrl_hum
+/// latching on a ctrl_meas write, FORCED and NORMAL conversion timing (datasheet
+/// typical formula), skip patterns for disabled channels, ignored config writes in
+/// NORMAL mode, 4- and 3-wire SPI framing, and bus time per transaction. Register
+/// accesses are logged in bus order for wire-level assertions. The IIR filter is
+/// not modeled; conversions publish the ADC values set with setAdc().
+///
+/// Time only advances through advanceUs() and bus transactions, so runs are
+/// deterministic. Wire it with attach() or attachSpi() and pass nowMs() to tick().
+class SimBme280 {
+public:
+  static constexpr uint8_t CHIP_ID = 0x60;
+  static constexpr uint32_t RESET_NVM_US = 2000;
+
+  SimBme280() { powerOn(); }
+
+  /// Power-on state: registers at reset values, calibration loaded
+  void powerOn() {
+    memset(_regs, 0, sizeof(_regs));
+    // Datasheet section 8.2 example coefficients (T1..P9), typical humidity trim
+    static const uint8_t TP[26] = {0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC, 0x7D, 0x8E, 0x43,
+                                   0xD6, 0xD0, 0x0B, 0x27, 0x0B, 0x8C, 0x00, 0xF9, 0xFF,
+                                   0x8C, 0x3C, 0xF8, 0xC6, 0x70, 0x17, 0x00, 0x4B};
+    static const uint8_t H[7] = {0x6A, 0x01, 0x00, 0x13, 0x2A, 0x03, 0x1E};
+    memcpy(&_regs[REG_CALIB_TP], TP, sizeof(TP));
+    memcpy(&_regs[REG_CALIB_H], H, sizeof(H));
+    _regs[REG_CHIP_ID] = CHIP_ID;
+    _latchedHum = 0;
+    _mode = 0;
+    _convEndUs = 0;
+    _nextCycleUs = 0;
+    _nvmEndUs = 0;
+    _converting = false;
+    _nvmBusy = false;
+    _publishSkipPatterns();
+  }
+
+  /// Wire the simulator into a driver Config (I2C transport and clock)
+  void attach(BME280::Config& cfg) {
+    cfg.bus = BME280::BusType::I2C;
+    cfg.i2cWrite = &SimBme280::i2cWrite;
+    cfg.i2cWriteRead = &SimBme280::i2cWriteRead;
+    cfg.i2cUser = this;
+    cfg.i2cAddress = address;
+    cfg.clockUs = &SimBme280::clock;
+    cfg.clockUser = this;
+    _spi3Wire = false;
+  }
+
+  /// Wire the simulator into a driver Config as a SPI device (4- or 3-wire)
+  /// In 3-wire mode reads return 0xFF until spi3w_en is set, as SDO stays released.
+  void attachSpi(BME280::Config& cfg, BME280::BusType bus) {
+    cfg.bus = bus;
+    cfg.spiWrite = &SimBme280::spiWrite;
+    cfg.spiWriteRead = &SimBme280::spiWriteRead;
+    cfg.spiUser = this;
+    cfg.clockUs = &SimBme280::clock;
+    cfg.clockUser = this;
+    _spi3Wire = (bus == BME280::BusType::SPI_3WIRE);
+  }
+
+  // --- Configuration -------------------------------------------------------
+
+  uint8_t address = 0x76;                 ///< Responding I2C address
+  uint32_t busHz = 400000;                ///< SCL frequency for bus time
+  uint32_t transactionOverheadUs = 0;     ///< Extra time per transaction (host stack)
+  uint32_t conversionExtraUs = 0;         ///< Added to every conversion (slow part)
+
+  /// ADC values published by the next conversion (20/20/16 bit)
+  void setAdc(int32_t adcP, int32_t adcT, int32_t adcH) {
+    _adcP = adcP;
+    _adcT = adcT;
+    _adcH = adcH;
+  }
+
+  /// NACK the next count transactions
+  void injectNacks(uint32_t count) { _nackNext = count; }
+
+  /// Keep im_update set after a soft reset until released (stuck NVM copy)
+  void holdImUpdate(bool hold) {
+    _holdImUpdate = hold;
+    _update();
+  }
+
+  /// NACK every n-th transaction (0 disables)
+  void nackEvery(uint32_t n) {
+    _nackEvery = n;
+    _nackPhase = 0;
+  }
+
+  // --- Time ---------------------------------------------------------------
+
+  void advanceUs(uint32_t us) {
+    _nowUs += us;
+    _update();
+  }
+  uint64_t nowUs() const { return _nowUs; }
+  uint32_t nowMs() const { return static_cast<uint32_t>(_nowUs / 1000U); }
+
+  // --- Counters -----------------------------------------------------------
+
+  struct Counters {
+    uint32_t writes = 0;       ///< Write transactions
+    uint32_t reads = 0;        ///< Write-read transactions
+    uint32_t bytes = 0;        ///< Bytes on the bus (excluding address bytes)
+    uint32_t nacks = 0;        ///< Injected failures
+    uint32_t conversions = 0;  ///< Completed conversions
+    uint32_t ignoredConfigWrites = 0;  ///< config writes dropped in NORMAL mode
+    uint32_t badControlBytes = 0;  ///< SPI control bytes with the wrong R/W bit
+  };
+
+  const Counters& counters() const { return _counters; }
+  void resetCounters() {
+    _counters = Counters();
+    _accessCount = 0;
+  }
+
+  // --- Access log ---------------------------------------------------------
+
+  /// One register access: a written pair, or the start register of a burst read
+  struct Access {
+    bool write = false;
+    uint8_t reg = 0;
+    uint8_t value = 0;  ///< Written value, or burst length for reads
+    uint8_t control = 0;  ///< Byte on the wire: SPI control byte, or the I2C register
+    uint32_t transaction = 0;  ///< Transaction index since resetCounters()
+  };
+
+  static constexpr size_t LOG_DEPTH = 256;
+
+  /// Accesses since resetCounters(); logging stops after LOG_DEPTH entries
+  size_t accessCount() const { return _accessCount < LOG_DEPTH ? _accessCount : LOG_DEPTH; }
+  const Access& access(size_t i) const { return _log[i]; }
+
+  /// Direct register access for assertions
+  uint8_t reg(uint8_t addr) const { return _regs[addr]; }
+
+  // --- Transport callbacks --------------------------------------------------
+
+  static Status i2cWrite(uint8_t addr, const uint8_t* data, size_t len,
+                         uint32_t timeoutMs, void* user) {
+    (void)timeoutMs;
+    return static_cast<SimBme280*>(user)->_write(addr, data, len);
+  }
+
+  static Status i2cWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                             uint8_t* rxData, size_t rxLen, uint32_t timeoutMs, void* user) {
+    (void)timeoutMs;
+    return static_cast<SimBme280*>(user)->_writeRead(addr, txData, txLen, rxData, rxLen);
+  }
+
+  static Status spiWrite(const uint8_t* data, size_t len, uint32_t timeoutMs, void* user) {
+    (void)timeoutMs;
+    return static_cast<SimBme280*>(user)->_spiWrite(data, len);
+  }
+
+  static Status spiWriteRead(const uint8_t* txData, size_t txLen, uint8_t* rxData, size_t rxLen,
+                             uint32_t timeoutMs, void* user) {
+    (void)timeoutMs;
+    return static_cast<SimBme280*>(user)->_spiWriteRead(txData, txLen, rxData, rxLen);
+  }
+
+  static uint64_t clock(void* user) { return static_cast<SimBme280*>(user)->_nowUs; }
+
+private:
+  static constexpr uint8_t REG_CALIB_TP = 0x88;
+  static constexpr uint8_t REG_CHIP_ID = 0xD0;
+  static constexpr uint8_t REG_RESET = 0xE0;
+  static constexpr uint8_t REG_CALIB_H = 0xE1;
+  static constexpr uint8_t REG_CTRL_HUM = 0xF2;
+  static constexpr uint8_t REG_STATUS = 0xF3;
+  static constexpr uint8_t REG_CTRL_MEAS = 0xF4;
+  static constexpr uint8_t REG_CONFIG = 0xF5;
+  static constexpr uint8_t REG_PRESS_MSB = 0xF7;
+  static constexpr uint8_t RESET_WORD = 0xB6;
+  static constexpr uint8_t SPI_READ_BIT = 0x80;
+  static constexpr uint8_t STATUS_MEASURING = 0x08;
+  static constexpr uint8_t STATUS_IM_UPDATE = 0x01;
+
+  static uint32_t _osrsCount(uint8_t bits) {
+    static const uint8_t COUNT[8] = {0, 1, 2, 4, 8, 16, 16, 16};
+    return COUNT[bits & 0x07];
+  }
+
+  /// Datasheet typical measurement time in us
+  uint32_t _measureUs() const {
+    const uint32_t t = _osrsCount(_regs[REG_CTRL_MEAS] >> 5);
+    const uint32_t p = _osrsCount(_regs[REG_CTRL_MEAS] >> 2);
+    const uint32_t h = _osrsCount(_latchedHum);
+    uint32_t us = 1000 + 2000 * t;
+    if (p != 0) {
+      us += 2000 * p + 500;
+    }
+    if (h != 0) {
+      us += 2000 * h + 500;
+    }
+    return us + conversionExtraUs;
+  }
+
+  uint32_t _standbyUs() const {
+    static const uint32_t STANDBY_US[8] = {500, 62500, 125000, 250000,
+                                           500000, 1000000, 10000, 20000};
+    return STANDBY_US[_regs[REG_CONFIG] >> 5];
+  }
+
+  bool _reached(uint64_t deadlineUs) const { return _nowUs >= deadlineUs; }
+
+  void _update() {
+    if (_nvmBusy && !_holdImUpdate && _reached(_nvmEndUs)) {
+      _nvmBusy = false;
+    }
+    // Replay every conversion edge that elapsed since the last update
+    for (;;) {
+      if (_converting && _reached(_convEndUs)) {
+        _finishConversion();
+      } else if (_mode == MODE_NORMAL && !_converting && _reached(_nextCycleUs)) {
+        _startConversion(_nextCycleUs);
+      } else {
+        break;
+      }
+    }
+    uint8_t status = 0;
+    if (_converting) {
+      status |= STATUS_MEASURING;
+    }
+    if (_nvmBusy) {
+      status |= STATUS_IM_UPDATE;
+    }
+    _regs[REG_STATUS] = status;
+  }
+
+  static constexpr uint8_t MODE_SLEEP = 0;
+  static constexpr uint8_t MODE_FORCED = 1;
+  static constexpr uint8_t MODE_NORMAL = 3;
+
+  void _startConversion(uint64_t startUs) {
+    _converting = true;
+    _convEndUs = startUs + _measureUs();
+  }
+
+  void _finishConversion() {
+    _converting = false;
+    _counters.conversions++;
+    const uint8_t meas = _regs[REG_CTRL_MEAS];
+    const int32_t p = (_osrsCount(meas >> 2) != 0) ? _adcP : 0x80000;
+    const int32_t t = (_osrsCount(meas >> 5) != 0) ? _adcT : 0x80000;
+    const int32_t h = (_osrsCount(_latchedHum) != 0) ? _adcH : 0x8000;
+    _publish(p, t, h);
+    if (_mode == MODE_FORCED) {
+      _mode = MODE_SLEEP;
+      _regs[REG_CTRL_MEAS] = static_cast<uint8_t>(meas & ~0x03);
+    } else if (_mode == MODE_NORMAL) {
+      _nextCycleUs = _convEndUs + _standbyUs();
+    }
+  }
+
+  void _publish(int32_t p, int32_t t, int32_t h) {
+    uint8_t* d = &_regs[REG_PRESS_MSB];
+    d[0] = static_cast<uint8_t>(p >> 12);
+    d[1] = static_cast<uint8_t>(p >> 4);
+    d[2] = static_cast<uint8_t>((p & 0x0F) << 4);
+    d[3] = static_cast<uint8_t>(t >> 12);
+    d[4] = static_cast<uint8_t>(t >> 4);
+    d[5] = static_cast<uint8_t>((t & 0x0F) << 4);
+    d[6] = static_cast<uint8_t>(h >> 8);
+    d[7] = static_cast<uint8_t>(h);
+  }
+
+  void _publishSkipPatterns() { _publish(0x80000, 0x80000, 0x8000); }
+
+  void _writeRegister(uint8_t reg, uint8_t value) {
+    switch (reg) {
+      case REG_RESET:
+        if (value == RESET_WORD) {
+          powerOn();
+          _nvmBusy = true;
+          _nvmEndUs = _nowUs + RESET_NVM_US;
+        }
+        break;
+      case REG_CTRL_HUM:
+        _regs[reg] = value & 0x07;
+        break;
+      case REG_CTRL_MEAS: {
+        _regs[reg] = value;
+        _latchedHum = _regs[REG_CTRL_HUM];
+        const uint8_t mode = value & 0x03;
+        _mode = (mode == 2) ? MODE_FORCED : mode;
+        if (_mode == MODE_FORCED) {
+          _startConversion(_nowUs);
+        } else if (_mode == MODE_NORMAL) {
+          _nextCycleUs = _converting ? _convEndUs : _nowUs;
+        }
+        break;
+      }
+      case REG_CONFIG:
+        if (_mode == MODE_NORMAL) {
+          _counters.ignoredConfigWrites++;
+        } else {
+          _regs[reg] = value & 0xFD;
+        }
+        break;
+      default:
+        break;  // read-only or reserved
+    }
+  }
+
+  /// Advance the clock by the time a transaction occupies the bus
+  void _busTime(size_t txLen, size_t rxLen) {
+    // START, address byte, data bytes (9 clocks each), repeated START + address, STOP
+    uint64_t clocks = 1 + 9 + 9 * static_cast<uint64_t>(txLen) + 1;
+    if (rxLen > 0) {
+      clocks += 1 + 9 + 9 * static_cast<uint64_t>(rxLen);
+    }
+    const uint64_t us = (clocks * 1000000U + busHz - 1) / busHz + transactionOverheadUs;
+    advanceUs(static_cast<uint32_t>(us));
+  }
+
+  void _logAccess(bool write, uint8_t reg, uint8_t value, uint8_t control,
+                  uint32_t transaction) {
+    if (_accessCount < LOG_DEPTH) {
+      Access& entry = _log[_accessCount];
+      entry.write = write;
+      entry.reg = reg;
+      entry.value = value;
+      entry.control = control;
+      entry.transaction = transaction;
+    }
+    _accessCount++;
+  }
+
+  bool _nack() {
+    if (_nackNext > 0) {
+      _nackNext--;
+      _counters.nacks++;
+      return true;
+    }
+    if (_nackEvery != 0 && ++_nackPhase >= _nackEvery) {
+      _nackPhase = 0;
+      _counters.nacks++;
+      return true;
+    }
+    return false;
+  }
+
+  Status _write(uint8_t addr, const uint8_t* data, size_t len) {
+    _busTime(len, 0);
+    if (addr != address || _nack()) {
+      return Status::Error(Err::I2C_ERROR, "I2C NACK", 2);
+    }
+    _counters.writes++;
+    _counters.bytes += static_cast<uint32_t>(len);
+    const uint32_t transaction = _counters.writes + _counters.reads;
+    // Multi-byte writes are register/value pairs
+    for (size_t i = 0; i + 1 < len; i += 2) {
+      _logAccess(true, data[i], data[i + 1], data[i], transaction);
+      _writeRegister(data[i], data[i + 1]);
+    }
+    _update();
+    return Status::Ok();
+  }
+
+  Status _writeRead(uint8_t addr, const uint8_t* tx, size_t txLen, uint8_t* rx, size_t rxLen) {
+    _busTime(txLen, rxLen);
+    if (addr != address || txLen != 1 || _nack()) {
+      return Status::Error(Err::I2C_ERROR, "I2C NACK", 2);
+    }
+    _counters.reads++;
+    _counters.bytes += static_cast<uint32_t>(txLen + rxLen);
+    _logAccess(false, tx[0], static_cast<uint8_t>(rxLen), tx[0],
+               _counters.writes + _counters.reads);
+    _update();
+    // Burst reads auto-increment through the map
+    for (size_t i = 0; i < rxLen; ++i) {
+      rx[i] = _regs[static_cast<uint8_t>(tx[0] + i)];
+    }
+    return Status::Ok();
+  }
+
+  // SPI reuses the I2C bus-time model; the register map has no address phase
+  Status _spiWrite(const uint8_t* data, size_t len) {
+    _busTime(len, 0);
+    if (_nack()) {
+      return Status::Error(Err::I2C_ERROR, "SPI transfer failed", 2);
+    }
+    _counters.writes++;
+    _counters.bytes += static_cast<uint32_t>(len);
+    const uint32_t transaction = _counters.writes + _counters.reads;
+    // Control byte: bit 7 clear for a write, bits 6..0 select register 0x80..0xFF
+    for (size_t i = 0; i + 1 < len; i += 2) {
+      const uint8_t control = data[i];
+      if (control & SPI_READ_BIT) {
+        _counters.badControlBytes++;
+        continue;
+      }
+      const uint8_t reg = static_cast<uint8_t>(control | SPI_READ_BIT);
+      _logAccess(true, reg, data[i + 1], control, transaction);
+      _writeRegister(reg, data[i + 1]);
+    }
+    _update();
+    return Status::Ok();
+  }
+
+  Status _spiWriteRead(const uint8_t* tx, size_t txLen, uint8_t* rx, size_t rxLen) {
+    _busTime(txLen, rxLen);
+    if (txLen != 1 || _nack()) {
+      return Status::Error(Err::I2C_ERROR, "SPI transfer failed", 2);
+    }
+    _counters.reads++;
+    _counters.bytes += static_cast<uint32_t>(txLen + rxLen);
+    const uint8_t control = tx[0];
+    _logAccess(false, static_cast<uint8_t>(control | SPI_READ_BIT), static_cast<uint8_t>(rxLen),
+               control, _counters.writes + _counters.reads);
+    _update();
+    if (!(control & SPI_READ_BIT)) {
+      _counters.badControlBytes++;
+    }
+    const bool driven = (control & SPI_READ_BIT) &&
+                        (!_spi3Wire || (_regs[REG_CONFIG] & 0x01) != 0);
+    for (size_t i = 0; i < rxLen; ++i) {
+      rx[i] = driven ? _regs[static_cast<uint8_t>(control + i)] : 0xFF;
+    }
+    return Status::Ok();
+  }
+
+  uint8_t _regs[256] = {};
+  Access _log[LOG_DEPTH];
+  size_t _accessCount = 0;
+  uint8_t _latchedHum = 0;
+  uint8_t _mode = 0;
+  bool _converting = false;
+  bool _nvmBusy = false;
+  bool _holdImUpdate = false;
+  bool _spi3Wire = false;
+  uint64_t _nowUs = 1000000;
+  uint64_t _convEndUs = 0;
+  uint64_t _nextCycleUs = 0;
+  uint64_t _nvmEndUs = 0;
+  int32_t _adcP = 415148;   // Datasheet example ADC values
+  int32_t _adcT = 519888;
+  int32_t _adcH = 30000;
+  uint32_t _nackNext = 0;
+  uint32_t _nackEvery = 0;
+  uint32_t _nackPhase = 0;
+  Counters _counters;
+};
+
+} // namespace sim
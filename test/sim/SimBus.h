@@ -0,0 +1,78 @@
+/// @file SimBus.h
+/// @brief Shared I2C bus over several SimBme280 devices for host-native tests
+/// @note NOT part of the library - tests only
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BME280/BME280.h"
+#include "SimBme280.h"
+
+namespace sim {
+
+/// Offers every transaction to every device, like a real wire: each device spends
+/// the bus time, which keeps their clocks in step, and only the addressed one
+/// answers. Give the devices distinct SimBme280::address values before attach().
+class SimBus {
+public:
+  static constexpr size_t MAX_DEVICES = 4;
+
+  /// Add a device to the bus; returns false when the bus is full
+  bool add(SimBme280& dev) {
+    if (_count >= MAX_DEVICES) {
+      return false;
+    }
+    _devs[_count++] = &dev;
+    return true;
+  }
+
+  /// Wire a driver Config to dev through this bus (dev must be added first)
+  void attach(BME280::Config& cfg, SimBme280& dev) {
+    dev.attach(cfg);
+    cfg.i2cWrite = &SimBus::i2cWrite;
+    cfg.i2cWriteRead = &SimBus::i2cWriteRead;
+    cfg.i2cUser = this;
+  }
+
+  /// Advance every device's clock
+  void advanceUs(uint32_t us) {
+    for (size_t i = 0; i < _count; ++i) {
+      _devs[i]->advanceUs(us);
+    }
+  }
+
+  uint32_t nowMs() const { return (_count > 0) ? _devs[0]->nowMs() : 0; }
+
+  static Status i2cWrite(uint8_t addr, const uint8_t* data, size_t len,
+                         uint32_t timeoutMs, void* user) {
+    SimBus* self = static_cast<SimBus*>(user);
+    Status result = Status::Error(Err::I2C_ERROR, "I2C NACK", 2);
+    for (size_t i = 0; i < self->_count; ++i) {
+      const Status st = SimBme280::i2cWrite(addr, data, len, timeoutMs, self->_devs[i]);
+      if (self->_devs[i]->address == addr) {
+        result = st;
+      }
+    }
+    return result;
+  }
+
+  static Status i2cWriteRead(uint8_t addr, const uint8_t* txData, size_t txLen,
+                             uint8_t* rxData, size_t rxLen, uint32_t timeoutMs, void* user) {
+    SimBus* self = static_cast<SimBus*>(user);
+    Status result = Status::Error(Err::I2C_ERROR, "I2C NACK", 2);
+    for (size_t i = 0; i < self->_count; ++i) {
+      const Status st = SimBme280::i2cWriteRead(addr, txData, txLen, rxData, rxLen, timeoutMs,
+                                                self->_devs[i]);
+      if (self->_devs[i]->address == addr) {
+        result = st;
+      }
+    }
+    return result;
+  }
+
+private:
+  SimBme280* _devs[MAX_DEVICES] = {};
+  size_t _count = 0;
+};
+
+}  // namespace sim
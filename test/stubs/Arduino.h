@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <string>
 
 // Basic types
 using byte = uint8_t;